@@ -0,0 +1,109 @@
+#include "ArrowBatch.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// The schema then the array, as the .Net side reads them.
+struct ArrowBatchData
+{
+	ArrowSchema schema;
+	ArrowArray array;
+};
+
+/*static*/ SEXP ArrowBatch::alloc(ArrowSchema** schema, ArrowArray** array)
+{
+	SEXP tag = PROTECT(Rf_mkString(ARROW_BATCH_TAG));
+	SEXP sexp = PROTECT(R_MakeExternalPtr(NULL, tag, R_NilValue));
+	R_RegisterCFinalizerEx(sexp, &ArrowBatch::finalize, TRUE);
+
+	ArrowBatchData* data = (ArrowBatchData*)calloc(1, sizeof(ArrowBatchData));
+	if (data == NULL)
+	{
+		UNPROTECT(2);
+		Rf_error("Unable to allocate an arrow batch\n");
+	}
+	R_SetExternalPtrAddr(sexp, data);
+
+	*schema = &data->schema;
+	*array = &data->array;
+	UNPROTECT(2);
+	return sexp;
+}
+
+/*static*/ bool ArrowBatch::is(SEXP sexp)
+{
+	if (TYPEOF(sexp) != EXTPTRSXP) return false;
+
+	SEXP tag = R_ExternalPtrTag(sexp);
+	return TYPEOF(tag) == STRSXP && LENGTH(tag) > 0
+		&& strcmp(CHAR(STRING_ELT(tag, 0)), ARROW_BATCH_TAG) == 0;
+}
+
+/*static*/ SEXP ArrowBatch::exportFromR(SEXP x)
+{
+	ArrowSchema* schema;
+	ArrowArray* array;
+	SEXP batch = PROTECT(alloc(&schema, &array));
+
+	SEXP result = callHelper("arrow_export", x, batch);
+	UNPROTECT(1);
+
+	if (result == NULL)
+	{
+		release(batch);
+		return R_NilValue;
+	}
+	return batch;
+}
+
+/*static*/ SEXP ArrowBatch::importToR(SEXP batch)
+{
+	PROTECT(batch);
+	SEXP result = callHelper("arrow_import", NULL, batch);
+	if (result != NULL) PROTECT(result);
+
+	// The structs have been moved, otherwise they can't be used anymore
+	release(batch);
+
+	UNPROTECT(result != NULL ? 2 : 1);
+	return result == NULL ? R_NilValue : result;
+}
+
+/*static*/ void ArrowBatch::release(SEXP batch)
+{
+	ArrowBatchData* data = (ArrowBatchData*)R_ExternalPtrAddr(batch);
+	if (data == NULL) return;
+
+	if (data->array.release != NULL)
+		data->array.release(&data->array);
+	if (data->schema.release != NULL)
+		data->schema.release(&data->schema);
+
+	free(data);
+	R_ClearExternalPtr(batch);
+}
+
+/*static*/ void ArrowBatch::finalize(SEXP batch)
+{
+	release(batch);
+}
+
+/*static*/ SEXP ArrowBatch::callHelper(const char* name, SEXP x, SEXP batch)
+{
+	ArrowBatchData* data = (ArrowBatchData*)R_ExternalPtrAddr(batch);
+
+	// The arrow package takes the structs addresses as doubles
+	SEXP ns = PROTECT(R_FindNamespace(Rf_mkString("sharper")));
+	SEXP fun = PROTECT(Rf_findFun(Rf_install(name), ns));
+	SEXP arrayPtr = PROTECT(Rf_ScalarReal((double)(uintptr_t)&data->array));
+	SEXP schemaPtr = PROTECT(Rf_ScalarReal((double)(uintptr_t)&data->schema));
+	SEXP call = PROTECT(x == NULL
+		? Rf_lang3(fun, arrayPtr, schemaPtr)
+		: Rf_lang4(fun, x, arrayPtr, schemaPtr));
+
+	int hasError = 0;
+	SEXP result = R_tryEval(call, R_GlobalEnv, &hasError);
+	UNPROTECT(5);
+
+	return hasError ? NULL : result;
+}
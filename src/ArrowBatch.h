@@ -0,0 +1,83 @@
+#ifndef __ARROW_BATCH_H__
+#define __ARROW_BATCH_H__
+
+#include <stdint.h>
+
+#include <R.h>
+#include <Rinternals.h>
+
+// The Arrow C data interface, a stable ABI copied as is from the Arrow format specification.
+// https://arrow.apache.org/docs/format/CDataInterface.html
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+	// Array type description
+	const char* format;
+	const char* name;
+	const char* metadata;
+	int64_t flags;
+	int64_t n_children;
+	struct ArrowSchema** children;
+	struct ArrowSchema* dictionary;
+
+	// Release callback
+	void (*release)(struct ArrowSchema*);
+	// Opaque producer-specific data
+	void* private_data;
+};
+
+struct ArrowArray {
+	// Array data description
+	int64_t length;
+	int64_t null_count;
+	int64_t offset;
+	int64_t n_buffers;
+	int64_t n_children;
+	const void** buffers;
+	struct ArrowArray** children;
+	struct ArrowArray* dictionary;
+
+	// Release callback
+	void (*release)(struct ArrowArray*);
+	// Opaque producer-specific data
+	void* private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
+#define ARROW_BATCH_TAG ".ArrowBatch"
+
+// A record batch crossing between R and .Net through the Arrow C data interface, without any copy.
+// Its schema then its array are held by an R external pointer tagged ARROW_BATCH_TAG.
+// The consumer moves them, the ones which haven't been moved are released with the external pointer.
+// On the R side the arrow package exports and imports them, through the sharper arrow_export and arrow_import functions.
+class ArrowBatch
+{
+public:
+	// Allocates empty structs held by a new external pointer, which isn't protected.
+	static SEXP alloc(ArrowSchema** schema, ArrowArray** array);
+
+	static bool is(SEXP sexp);
+
+	// Exports an arrow RecordBatch or Table into a new external pointer, which isn't protected.
+	// Returns R_NilValue if the arrow package failed, its error is printed.
+	static SEXP exportFromR(SEXP x);
+
+	// Imports the batch as an arrow RecordBatch, the structs are moved then freed.
+	// Returns R_NilValue if the arrow package failed, its error is printed.
+	static SEXP importToR(SEXP batch);
+
+	// Releases the structs which haven't been moved then frees them, the external pointer is cleared.
+	static void release(SEXP batch);
+
+private:
+	static void finalize(SEXP batch);
+	static SEXP callHelper(const char* name, SEXP x, SEXP batch);
+};
+
+#endif // !__ARROW_BATCH_H__
@@ -0,0 +1,189 @@
+#include "CallStats.h"
+
+#include <chrono>
+
+bool CallStats::enabled = false;
+std::unordered_map<std::string, MemberStats> CallStats::members;
+int64_t CallStats::createdObjects = 0;
+int64_t CallStats::releasedObjects = 0;
+int64_t CallStats::releaseBatches = 0;
+
+/*static*/ CallTimer CallStats::start()
+{
+	CallTimer timer = { 0, 0 };
+	if (!enabled) return timer;
+
+	timer.start = now();
+	timer.createdObjects = createdObjects;
+	return timer;
+}
+
+/*static*/ void CallStats::stop(const CallTimer& timer, const char* entryPoint, const char* typeName, const char* memberName, int64_t bytesToNet, SEXP result, bool succeeded)
+{
+	// Nothing to record if the stats have been enabled during the call
+	if (!enabled || timer.start == 0) return;
+
+	int64_t elapsed = now() - timer.start;
+
+	std::string key(entryPoint);
+	key.append(1, '|').append(typeName == NULL ? "" : typeName);
+	key.append(1, '|').append(memberName == NULL ? "" : memberName);
+
+	std::unordered_map<std::string, MemberStats>::iterator it = members.find(key);
+	if (it == members.end())
+	{
+		MemberStats stats = {};
+		stats.entryPoint = entryPoint;
+		stats.typeName = typeName == NULL ? "" : typeName;
+		stats.memberName = memberName == NULL ? "" : memberName;
+		it = members.insert(std::make_pair(key, stats)).first;
+	}
+
+	MemberStats& stats = it->second;
+	stats.calls++;
+	if (!succeeded) stats.errors++;
+	stats.totalNs += elapsed;
+	if (elapsed > stats.maxNs) stats.maxNs = elapsed;
+	stats.bytesToNet += bytesToNet;
+	stats.bytesToR += sizeOf(result);
+	stats.objectsCreated += createdObjects - timer.createdObjects;
+	stats.histogram[bucketOf(elapsed)]++;
+}
+
+/*static*/ int64_t CallStats::sizeOf(SEXP sexp)
+{
+	if (sexp == NULL) return 0;
+
+	R_xlen_t length;
+	int64_t size = 0;
+	switch (TYPEOF(sexp))
+	{
+	case REALSXP:
+		return (int64_t)XLENGTH(sexp) * sizeof(double);
+	case INTSXP:
+	case LGLSXP:
+		return (int64_t)XLENGTH(sexp) * sizeof(int);
+	case CPLXSXP:
+		return (int64_t)XLENGTH(sexp) * sizeof(Rcomplex);
+	case RAWSXP:
+		return (int64_t)XLENGTH(sexp);
+	case STRSXP:
+		length = XLENGTH(sexp);
+		for (R_xlen_t i = 0; i < length; i++)
+			size += LENGTH(STRING_ELT(sexp, i));
+		return size;
+	case VECSXP:
+		length = XLENGTH(sexp);
+		for (R_xlen_t i = 0; i < length; i++)
+			size += sizeOf(VECTOR_ELT(sexp, i));
+		return size;
+	default:
+		return 0;
+	}
+}
+
+/*static*/ void CallStats::reset()
+{
+	members.clear();
+	createdObjects = 0;
+	releasedObjects = 0;
+	releaseBatches = 0;
+}
+
+/*static*/ SEXP CallStats::toSexp()
+{
+	const char* names[] = {
+		"entry_point", "type", "member", "calls", "errors", "total_ms", "mean_us",
+		"p50_us", "p90_us", "p99_us", "max_us", "bytes_to_net", "bytes_to_r", "objects_created" };
+	const int columnsCount = sizeof(names) / sizeof(names[0]);
+	R_xlen_t size = (R_xlen_t)members.size();
+
+	SEXP columns = PROTECT(Rf_allocVector(VECSXP, columnsCount));
+	SEXP columnNames = PROTECT(Rf_allocVector(STRSXP, columnsCount));
+	for (int i = 0; i < columnsCount; i++)
+	{
+		SET_STRING_ELT(columnNames, i, Rf_mkChar(names[i]));
+		SET_VECTOR_ELT(columns, i, Rf_allocVector(i < 3 ? STRSXP : REALSXP, size));
+	}
+	Rf_setAttrib(columns, R_NamesSymbol, columnNames);
+
+	R_xlen_t row = 0;
+	for (std::unordered_map<std::string, MemberStats>::const_iterator it = members.begin(); it != members.end(); ++it, row++)
+	{
+		const MemberStats& stats = it->second;
+		SET_STRING_ELT(VECTOR_ELT(columns, 0), row, Rf_mkChar(stats.entryPoint.c_str()));
+		SET_STRING_ELT(VECTOR_ELT(columns, 1), row, Rf_mkChar(stats.typeName.c_str()));
+		SET_STRING_ELT(VECTOR_ELT(columns, 2), row, Rf_mkChar(stats.memberName.c_str()));
+		REAL(VECTOR_ELT(columns, 3))[row] = (double)stats.calls;
+		REAL(VECTOR_ELT(columns, 4))[row] = (double)stats.errors;
+		REAL(VECTOR_ELT(columns, 5))[row] = stats.totalNs / 1e6;
+		REAL(VECTOR_ELT(columns, 6))[row] = stats.totalNs / 1e3 / stats.calls;
+		REAL(VECTOR_ELT(columns, 7))[row] = percentile(stats, 0.5) / 1e3;
+		REAL(VECTOR_ELT(columns, 8))[row] = percentile(stats, 0.9) / 1e3;
+		REAL(VECTOR_ELT(columns, 9))[row] = percentile(stats, 0.99) / 1e3;
+		REAL(VECTOR_ELT(columns, 10))[row] = stats.maxNs / 1e3;
+		REAL(VECTOR_ELT(columns, 11))[row] = (double)stats.bytesToNet;
+		REAL(VECTOR_ELT(columns, 12))[row] = (double)stats.bytesToR;
+		REAL(VECTOR_ELT(columns, 13))[row] = (double)stats.objectsCreated;
+	}
+
+	SEXP objects = PROTECT(Rf_allocVector(REALSXP, 3));
+	REAL(objects)[0] = (double)createdObjects;
+	REAL(objects)[1] = (double)releasedObjects;
+	REAL(objects)[2] = (double)releaseBatches;
+	SEXP objectsNames = PROTECT(Rf_allocVector(STRSXP, 3));
+	SET_STRING_ELT(objectsNames, 0, Rf_mkChar("created"));
+	SET_STRING_ELT(objectsNames, 1, Rf_mkChar("released"));
+	SET_STRING_ELT(objectsNames, 2, Rf_mkChar("release_batches"));
+	Rf_setAttrib(objects, R_NamesSymbol, objectsNames);
+
+	SEXP result = PROTECT(Rf_allocVector(VECSXP, 2));
+	SET_VECTOR_ELT(result, 0, columns);
+	SET_VECTOR_ELT(result, 1, objects);
+	SEXP resultNames = PROTECT(Rf_allocVector(STRSXP, 2));
+	SET_STRING_ELT(resultNames, 0, Rf_mkChar("calls"));
+	SET_STRING_ELT(resultNames, 1, Rf_mkChar("objects"));
+	Rf_setAttrib(result, R_NamesSymbol, resultNames);
+
+	UNPROTECT(6);
+	return result;
+}
+
+/*static*/ int64_t CallStats::now()
+{
+	return (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*static*/ int32_t CallStats::bucketOf(int64_t ns)
+{
+	if (ns < 4) return ns < 0 ? 0 : (int32_t)ns;
+
+	int32_t msb = 0;
+	for (int64_t v = ns; v > 1; v >>= 1)
+		msb++;
+
+	// The power of 2 then the 2 next bits
+	int32_t bucket = msb * 4 + (int32_t)((ns >> (msb - 2)) & 3);
+	return bucket < CALL_STATS_BUCKETS ? bucket : CALL_STATS_BUCKETS - 1;
+}
+
+/*static*/ double CallStats::percentile(const MemberStats& stats, double p)
+{
+	int64_t rank = (int64_t)(p * (stats.calls - 1)) + 1;
+	int64_t count = 0;
+	for (int32_t i = 0; i < CALL_STATS_BUCKETS; i++)
+	{
+		count += stats.histogram[i];
+		if (count < rank) continue;
+		if (i < 4) return i;
+
+		// Middle of the bucket
+		int32_t msb = i / 4;
+		double low = (double)(((int64_t)4 + i % 4) << (msb - 2));
+		double width = (double)((int64_t)1 << (msb - 2));
+		return low + width / 2;
+	}
+
+	return (double)stats.maxNs;
+}
@@ -0,0 +1,66 @@
+#ifndef __CALL_STATS_H__
+#define __CALL_STATS_H__
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+
+#include <R.h>
+#include <Rinternals.h>
+
+// 4 buckets per power of 2, so a latency is known within 20% from 1 ns to hours.
+#define CALL_STATS_BUCKETS 256
+
+struct MemberStats
+{
+	std::string entryPoint;
+	std::string typeName;
+	std::string memberName;
+	int64_t calls;
+	int64_t errors;
+	int64_t totalNs;
+	int64_t maxNs;
+	int64_t bytesToNet;
+	int64_t bytesToR;
+	int64_t objectsCreated;
+	int64_t histogram[CALL_STATS_BUCKETS];
+};
+
+// Taken when a call enters the host, then given back to record the call.
+struct CallTimer
+{
+	int64_t start;
+	int64_t createdObjects;
+};
+
+// Counters of the calls from R by entry point and member, they are recorded only once enabled.
+// The entry points are called from the R thread only, so the counters aren't synchronized.
+class CallStats
+{
+public:
+	static bool enabled;
+
+	static CallTimer start();
+	static void stop(const CallTimer& timer, const char* entryPoint, const char* typeName, const char* memberName, int64_t bytesToNet, SEXP result, bool succeeded);
+
+	static void objectCreated() { if (enabled) createdObjects++; }
+	static void objectsReleased(int64_t count) { if (enabled) { releasedObjects += count; releaseBatches++; } }
+
+	// Gets the size of the data held by an R vector, a list is counted with its items.
+	static int64_t sizeOf(SEXP sexp);
+
+	static void reset();
+	static SEXP toSexp();
+
+private:
+	static std::unordered_map<std::string, MemberStats> members;
+	static int64_t createdObjects;
+	static int64_t releasedObjects;
+	static int64_t releaseBatches;
+
+	static int64_t now();
+	static int32_t bucketOf(int64_t ns);
+	static double percentile(const MemberStats& stats, double p);
+};
+
+#endif // !__CALL_STATS_H__
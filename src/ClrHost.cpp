@@ -1,6 +1,11 @@
 #include "ClrHost.h"
+#include "CompletionQueue.h"
 
-ClrHost::ClrHost()
+#include <cstring>
+
+std::vector<SEXP> ClrHost::allocatedVectors;
+
+ClrHost::ClrHost() : _buffersInUse(false)
 {
 }
 
@@ -21,25 +26,36 @@ SEXP ClrHost::rCallStaticMethod(SEXP p)
 	p = CDR(p); // Skip the first parameter because of function name
 	const char* typeName = readStringFromSexp(p); p = CDR(p);
 	const char* methodName = readStringFromSexp(p); p = CDR(p);
+	CallTimer timer = CallStats::start();
+
+	// 2 - Prepare arguments and results into the reusable buffers
+	CallBuffers* buffers = acquireBuffers();
 	int32_t argsSize = 0;
-	int64_t* args = readParametersFromSexp(p, argsSize);
+	int64_t* args = readParametersFromSexp(p, argsSize, buffers);
+	int64_t* argsData = buffers->argsData.data();
+	int32_t resultsCapacity = argsSize + 1; // The returned value then the out or ref arguments
+	int64_t* results = reserveResults(resultsCapacity, buffers->results);
+	int32_t resultsSize = 0;
 
-	// 2 - Call delegate on clr runtime
-	int64_t* results;
-	int32_t resultsSize;
-	
-	bool isOk = callStaticMethod(typeName, methodName, args, argsSize, &results, &resultsSize);
+	// 3 - Call delegate on clr runtime
+	size_t allocatedCount = allocatedVectors.size();
+	bool isOk = callStaticMethod(typeName, methodName, args, argsData, argsSize, results, resultsCapacity, &resultsSize);
 	
-	delete[] args;
-
 	if (!isOk)
 	{
+		CallStats::stop(timer, "CallStaticMethod", typeName, methodName, buffers->argsBytes, NULL, false);
+		releaseBuffers(buffers);
+		releaseAllocatedVectors(allocatedCount);
 		Rf_error(getLastError());
 		return R_NilValue;
 	}
 	
-	// 3 - Convert and return the result
-	return WrapResults(results, resultsSize);
+	// 4 - Convert and return the result
+	SEXP sexp = wrapResultsOrRelease(results, resultsSize, buffers, allocatedCount);
+	CallStats::stop(timer, "CallStaticMethod", typeName, methodName, buffers->argsBytes, sexp, true);
+	releaseBuffers(buffers);
+	releaseAllocatedVectors(allocatedCount); // Now referenced by the returned list
+	return sexp;
 }
 
 SEXP ClrHost::rGetStaticProperty(SEXP p)
@@ -48,16 +64,20 @@ SEXP ClrHost::rGetStaticProperty(SEXP p)
 	p = CDR(p); // Skip the first parameter because of function name
 	const char* typeName = readStringFromSexp(p); p = CDR(p);
 	const char* propertyName = readStringFromSexp(p); p = CDR(p);
+	CallTimer timer = CallStats::start();
 
 	int64_t result;
 	
 	if(!getStaticProperty(typeName, propertyName, &result))
 	{
+		CallStats::stop(timer, "GetStaticProperty", typeName, propertyName, 0, NULL, false);
 		Rf_error(getLastError());
 		return R_NilValue;
 	}
 
-	return WrapResult(result);
+	SEXP sexp = WrapResult(result);
+	CallStats::stop(timer, "GetStaticProperty", typeName, propertyName, 0, sexp, true);
+	return sexp;
 }
 
 void ClrHost::rSetStaticProperty(SEXP p)
@@ -67,8 +87,11 @@ void ClrHost::rSetStaticProperty(SEXP p)
 	const char* typeName = readStringFromSexp(p); p = CDR(p);
 	const char* propertyName = readStringFromSexp(p); p = CDR(p);
 	int64_t value = (int64_t)CAR(p);
+	CallTimer timer = CallStats::start();
 
-	if (!setStaticProperty(typeName, propertyName, value))
+	bool isOk = setStaticProperty(typeName, propertyName, value);
+	CallStats::stop(timer, "SetStaticProperty", typeName, propertyName, CallStats::enabled ? CallStats::sizeOf(CAR(p)) : 0, NULL, isOk);
+	if (!isOk)
 		Rf_error(getLastError());
 
 }
@@ -78,23 +101,32 @@ SEXP ClrHost::rCreateObject(SEXP p)
 	// 1 - Get data from SEXP
 	p = CDR(p); // Skip the first parameter because of function name
 	const char* typeName = readStringFromSexp(p); p = CDR(p);
+	CallTimer timer = CallStats::start();
 	
 	// 2 - Prepare arguments to call proxy
+	CallBuffers* buffers = acquireBuffers();
 	int32_t argsSize = 0;
-	int64_t* args = readParametersFromSexp(p, argsSize);
+	int64_t* args = readParametersFromSexp(p, argsSize, buffers);
+	int64_t* argsData = buffers->argsData.data();
 
 	int64_t result;
-	bool isOk = createObject(typeName, args, argsSize, &result);
+	size_t allocatedCount = allocatedVectors.size();
+	bool isOk = createObject(typeName, args, argsData, argsSize, &result);
+	int64_t argsBytes = buffers->argsBytes;
 
-	delete[] args;
+	releaseBuffers(buffers);
+	releaseAllocatedVectors(allocatedCount);
 
 	if(!isOk)
 	{
+		CallStats::stop(timer, "CreateObject", typeName, NULL, argsBytes, NULL, false);
 		Rf_error(getLastError());
 		return R_NilValue;
 	}
 
-	return WrapResult(result);
+	SEXP sexp = WrapResult(result);
+	CallStats::stop(timer, "CreateObject", typeName, NULL, argsBytes, sexp, true);
+	return sexp;
 }
 
 SEXP ClrHost::rCallMethod(SEXP p)
@@ -103,27 +135,36 @@ SEXP ClrHost::rCallMethod(SEXP p)
 	p = CDR(p); // Skip the first parameter because of function name
 	int64_t objectPtr = readObjectPtrFromSexp(p); p = CDR(p);
 	const char* methodName = readStringFromSexp(p); p = CDR(p);
+	CallTimer timer = CallStats::start();
 
-	// 2 - Prepare arguments to call proxy
+	// 2 - Prepare arguments and results into the reusable buffers
+	CallBuffers* buffers = acquireBuffers();
 	int32_t argsSize = 0;
-	int64_t* args = readParametersFromSexp(p, argsSize);
+	int64_t* args = readParametersFromSexp(p, argsSize, buffers);
+	int64_t* argsData = buffers->argsData.data();
+	int32_t resultsCapacity = argsSize + 1; // The returned value then the out or ref arguments
+	int64_t* results = reserveResults(resultsCapacity, buffers->results);
+	int32_t resultsSize = 0;
 
 	// 3 - Call delegate on clr runtime
-	int64_t* results;
-	int32_t resultsSize;
-	
-	bool isOk = callMethod(objectPtr, methodName, args, argsSize, &results, &resultsSize);
-
-	delete[] args;
+	size_t allocatedCount = allocatedVectors.size();
+	bool isOk = callMethod(objectPtr, methodName, args, argsData, argsSize, results, resultsCapacity, &resultsSize);
 
 	if (!isOk)
 	{
+		CallStats::stop(timer, "CallMethod", NULL, methodName, buffers->argsBytes, NULL, false);
+		releaseBuffers(buffers);
+		releaseAllocatedVectors(allocatedCount);
 		Rf_error(getLastError());
 		return R_NilValue;
 	}
 
 	// 4 - Convert and return the result
-	return WrapResults(results, resultsSize);
+	SEXP sexp = wrapResultsOrRelease(results, resultsSize, buffers, allocatedCount);
+	CallStats::stop(timer, "CallMethod", NULL, methodName, buffers->argsBytes, sexp, true);
+	releaseBuffers(buffers);
+	releaseAllocatedVectors(allocatedCount); // Now referenced by the returned list
+	return sexp;
 }
 
 SEXP ClrHost::rGetProperty(SEXP p)
@@ -132,15 +173,19 @@ SEXP ClrHost::rGetProperty(SEXP p)
 	p = CDR(p); // Skip the first parameter because of function name
 	int64_t objectPtr = readObjectPtrFromSexp(p); p = CDR(p);
 	const char* propertyName = readStringFromSexp(p); p = CDR(p);
+	CallTimer timer = CallStats::start();
 
 	int64_t result;
 	if (!getProperty(objectPtr, propertyName, &result))
 	{
+		CallStats::stop(timer, "GetProperty", NULL, propertyName, 0, NULL, false);
 		Rf_error(getLastError());
 		return R_NilValue;
 	}
 
-	return WrapResult(result);
+	SEXP sexp = WrapResult(result);
+	CallStats::stop(timer, "GetProperty", NULL, propertyName, 0, sexp, true);
+	return sexp;
 }
 
 void ClrHost::rSetProperty(SEXP p)
@@ -150,9 +195,511 @@ void ClrHost::rSetProperty(SEXP p)
 	int64_t objectPtr = readObjectPtrFromSexp(p); p = CDR(p);
 	const char* propertyName = readStringFromSexp(p); p = CDR(p);
 	int64_t value = (int64_t)CAR(p);
+	CallTimer timer = CallStats::start();
+
+	bool isOk = setProperty(objectPtr, propertyName, value);
+	CallStats::stop(timer, "SetProperty", NULL, propertyName, CallStats::enabled ? CallStats::sizeOf(CAR(p)) : 0, NULL, isOk);
+	if (!isOk)
+		Rf_error(getLastError());
+}
+
+SEXP ClrHost::rPrepareMethod(SEXP p)
+{
+	// 1 - Get data from SEXP
+	p = CDR(p); // Skip the first parameter because of function name
+	SEXP target = CAR(p);
+	const char* typeName = NULL;
+	int64_t objectPtr = 0;
+	if (TYPEOF(target) == STRSXP)
+		typeName = readStringFromSexp(p);
+	else objectPtr = readObjectPtrFromSexp(p);
+	p = CDR(p);
+	const char* methodName = readStringFromSexp(p); p = CDR(p);
+
+	// 2 - Argument type names are optional, NULL means no overload disambiguation
+	SEXP argTypes = p == R_NilValue ? R_NilValue : CAR(p);
+	if (argTypes != R_NilValue && TYPEOF(argTypes) != STRSXP)
+		error("[ERROR] rPrepareMethod: argument types should be a character vector\n");
+
+	int32_t argTypesSize = argTypes == R_NilValue ? -1 : LENGTH(argTypes);
+	std::vector<const char*> argTypeNames;
+	for (int32_t i = 0; i < argTypesSize; i++)
+		argTypeNames.push_back(CHAR(STRING_ELT(argTypes, i)));
+
+	// 3 - A type name prepares a static method unless the optional flag says otherwise, i.e. for the generated R6 classes
+	int32_t isStatic = typeName != NULL;
+	if (p != R_NilValue && CDR(p) != R_NilValue)
+		isStatic = readFlagFromSexp(CDR(p));
+
+	// 4 - Resolve the call site once on clr runtime
+	CallTimer timer = CallStats::start();
+	int32_t handle;
+	if (!prepareMethod(typeName, objectPtr, isStatic, methodName, argTypeNames.data(), argTypesSize, &handle))
+	{
+		CallStats::stop(timer, "PrepareMethod", typeName, methodName, 0, NULL, false);
+		Rf_error(getLastError());
+		return R_NilValue;
+	}
+	CallStats::stop(timer, "PrepareMethod", typeName, methodName, 0, NULL, true);
+
+	// 5 - Keep the kinds of a method which only takes and returns scalars, its calls then skip the converters
+	int32_t kinds[MAX_SCALAR_ARGS + 1];
+	int32_t kindsSize = 0;
+	if (!getScalarSignature(handle, kinds, MAX_SCALAR_ARGS + 1, &kindsSize))
+		kindsSize = 0;
+	if ((size_t)handle >= _scalarSignatures.size())
+		_scalarSignatures.resize(handle + 1);
+	_scalarSignatures[handle].assign(kinds, kinds + kindsSize);
+
+	return Rf_ScalarInteger(handle);
+}
+
+SEXP ClrHost::rCallPreparedMethod(SEXP p)
+{
+	// 1 - Get data from SEXP
+	p = CDR(p); // Skip the first parameter because of function name
+	int32_t handle = readHandleFromSexp(p); p = CDR(p);
+	SEXP instance = CAR(p);
+	int64_t objectPtr = instance == R_NilValue ? 0 : (int64_t)instance; p = CDR(p);
+	CallTimer timer = CallStats::start();
+
+	// 2 - A method which only takes and returns scalars is called with raw values, when the arguments allow it
+	SEXP scalar;
+	if (handle >= 0 && (size_t)handle < _scalarSignatures.size() && !_scalarSignatures[handle].empty()
+		&& tryCallPreparedScalar(handle, objectPtr, p, timer, scalar))
+		return scalar;
+
+	// 3 - Prepare arguments and results into the reusable buffers
+	CallBuffers* buffers = acquireBuffers();
+	int32_t argsSize = 0;
+	int64_t* args = readParametersFromSexp(p, argsSize, buffers);
+	int64_t* argsData = buffers->argsData.data();
+	int32_t resultsCapacity = argsSize + 1; // The returned value then the out or ref arguments
+	int64_t* results = reserveResults(resultsCapacity, buffers->results);
+	int32_t resultsSize = 0;
+
+	// 4 - Call delegate on clr runtime without any name or overload resolution
+	size_t allocatedCount = allocatedVectors.size();
+	bool isOk = callPreparedMethod(handle, objectPtr, args, argsData, argsSize, results, resultsCapacity, &resultsSize);
+
+	// The prepared call sites are only known by their handle on this side
+	char member[16] = "";
+	if (CallStats::enabled)
+		snprintf(member, sizeof(member), "#%d", handle);
+
+	if (!isOk)
+	{
+		CallStats::stop(timer, "CallPreparedMethod", NULL, member, buffers->argsBytes, NULL, false);
+		releaseBuffers(buffers);
+		releaseAllocatedVectors(allocatedCount);
+		Rf_error(getLastError());
+		return R_NilValue;
+	}
+
+	// 5 - Convert and return the result
+	SEXP sexp = wrapResultsOrRelease(results, resultsSize, buffers, allocatedCount);
+	CallStats::stop(timer, "CallPreparedMethod", NULL, member, buffers->argsBytes, sexp, true);
+	releaseBuffers(buffers);
+	releaseAllocatedVectors(allocatedCount); // Now referenced by the returned list
+	return sexp;
+}
+
+bool ClrHost::tryCallPreparedScalar(int32_t handle, int64_t objectPtr, SEXP p, const CallTimer& timer, SEXP& result)
+{
+	const std::vector<int32_t>& kinds = _scalarSignatures[handle];
+	int32_t argsSize = (int32_t)kinds.size() - 1;
+	int64_t args[MAX_SCALAR_ARGS];
+	int64_t argsBytes = 0;
+
+	// 1 - Read each argument into a 64 bits slot. Only the plain scalars are read, 
+	// the converters could read differently a NA, a classed value or a matrix, so they keep these calls.
+	int32_t i = 0;
+	for (; i < argsSize && p != R_NilValue; i++, p = CDR(p))
+	{
+		SEXP el = CAR(p);
+		if (OBJECT(el) || Rf_isMatrix(el))
+			return false;
+
+		switch (kinds[i + 1])
+		{
+		case SCALAR_DOUBLE:
+			if (TYPEOF(el) != REALSXP || XLENGTH(el) != 1)
+				return false;
+			memcpy(&args[i], REAL(el), sizeof(double));
+			break;
+		case SCALAR_INTEGER:
+			if (TYPEOF(el) != INTSXP || XLENGTH(el) != 1 || INTEGER(el)[0] == NA_INTEGER)
+				return false;
+			args[i] = INTEGER(el)[0];
+			break;
+		case SCALAR_LOGICAL:
+			if (TYPEOF(el) != LGLSXP || XLENGTH(el) != 1 || LOGICAL(el)[0] == NA_LOGICAL)
+				return false;
+			args[i] = LOGICAL(el)[0];
+			break;
+		default:
+			return false;
+		}
+
+		if (CallStats::enabled)
+			argsBytes += CallStats::sizeOf(el);
+	}
+	if (i != argsSize || p != R_NilValue)
+		return false;
+
+	// 2 - .Net writes the result into its R scalar, allocated before the call
+	SEXP value;
+	void* data;
+	switch (kinds[0])
+	{
+	case SCALAR_DOUBLE: value = Rf_allocVector(REALSXP, 1); data = REAL(value); break;
+	case SCALAR_INTEGER: value = Rf_allocVector(INTSXP, 1); data = INTEGER(value); break;
+	case SCALAR_LOGICAL: value = Rf_allocVector(LGLSXP, 1); data = LOGICAL(value); break;
+	default: value = R_NilValue; data = NULL; break;
+	}
+	PROTECT(value);
+
+	// A safe point, unless .Net called back R
+	if (!_buffersInUse)
+		releaseDeferredObjects();
+
+	bool isOk = callPreparedScalar(handle, objectPtr, args, argsSize, data);
+
+	char member[16] = "";
+	if (CallStats::enabled)
+		snprintf(member, sizeof(member), "#%d", handle);
+
+	if (!isOk)
+	{
+		UNPROTECT(1);
+		CallStats::stop(timer, "CallPreparedScalar", NULL, member, argsBytes, NULL, false);
+		Rf_error(getLastError());
+		return false;
+	}
+
+	// 3 - Returned as a list, as the other prepared calls
+	result = PROTECT(Rf_allocVector(VECSXP, 1));
+	SET_VECTOR_ELT(result, 0, value);
+	UNPROTECT(2);
+	CallStats::stop(timer, "CallPreparedScalar", NULL, member, argsBytes, result, true);
+	return true;
+}
+
+SEXP ClrHost::rCallStaticMethodBatch(SEXP p)
+{
+	// 1 - Get data from SEXP
+	p = CDR(p); // Skip the first parameter because of function name
+	const char* typeName = readStringFromSexp(p); p = CDR(p);
+	const char* methodName = readStringFromSexp(p); p = CDR(p);
+	int32_t count = readCountFromSexp(p); p = CDR(p);
+	int32_t simplify = readFlagFromSexp(p); p = CDR(p);
+	CallTimer timer = CallStats::start();
+
+	// 2 - Prepare the arguments columns followed by the first call arguments
+	CallBuffers* buffers = acquireBuffers();
+	int32_t argsSize = 0;
+	int64_t* args = readParametersFromSexp(p, argsSize, buffers);
+	int64_t* argsData = buffers->argsData.data();
+
+	// 3 - Call all the batch on clr runtime at once
+	int64_t result;
+	size_t allocatedCount = allocatedVectors.size();
+	bool isOk = callStaticMethodBatch(typeName, methodName, count, simplify, args, argsData, argsSize, &result);
+	int64_t argsBytes = buffers->argsBytes;
+	releaseBuffers(buffers);
+
+	if (!isOk)
+	{
+		CallStats::stop(timer, "CallStaticMethodBatch", typeName, methodName, argsBytes, NULL, false);
+		releaseAllocatedVectors(allocatedCount);
+		Rf_error(getLastError());
+		return R_NilValue;
+	}
+
+	// 4 - Convert and return the results
+	SEXP sexp = wrapBatchResultOrRelease(result, allocatedCount);
+	CallStats::stop(timer, "CallStaticMethodBatch", typeName, methodName, argsBytes, sexp, true);
+	releaseAllocatedVectors(allocatedCount);
+	return sexp;
+}
+
+SEXP ClrHost::rCallMethodBatch(SEXP p)
+{
+	// 1 - Get data from SEXP
+	p = CDR(p); // Skip the first parameter because of function name
+	SEXP objects = CAR(p); p = CDR(p);
+	if (TYPEOF(objects) != VECSXP)
+		error("[ERROR] rCallMethodBatch: objects should be a list of .net object pointers\n");
+	const char* methodName = readStringFromSexp(p); p = CDR(p);
+	int32_t count = readCountFromSexp(p); p = CDR(p);
+	int32_t simplify = readFlagFromSexp(p); p = CDR(p);
+	CallTimer timer = CallStats::start();
+
+	// 2 - Prepare the arguments columns followed by the first call arguments
+	CallBuffers* buffers = acquireBuffers();
+	int32_t argsSize = 0;
+	int64_t* args = readParametersFromSexp(p, argsSize, buffers);
+	int64_t* argsData = buffers->argsData.data();
+
+	// 3 - Call all the batch on clr runtime at once
+	int64_t result;
+	size_t allocatedCount = allocatedVectors.size();
+	bool isOk = callMethodBatch((int64_t)objects, methodName, count, simplify, args, argsData, argsSize, &result);
+	int64_t argsBytes = buffers->argsBytes;
+	releaseBuffers(buffers);
+
+	if (!isOk)
+	{
+		CallStats::stop(timer, "CallMethodBatch", NULL, methodName, argsBytes, NULL, false);
+		releaseAllocatedVectors(allocatedCount);
+		Rf_error(getLastError());
+		return R_NilValue;
+	}
+
+	// 4 - Convert and return the results
+	SEXP sexp = wrapBatchResultOrRelease(result, allocatedCount);
+	CallStats::stop(timer, "CallMethodBatch", NULL, methodName, argsBytes, sexp, true);
+	releaseAllocatedVectors(allocatedCount);
+	return sexp;
+}
+
+SEXP ClrHost::rCallStaticMethodAsync(SEXP p)
+{
+	// 1 - Get data from SEXP
+	p = CDR(p); // Skip the first parameter because of function name
+	const char* typeName = readStringFromSexp(p); p = CDR(p);
+	const char* methodName = readStringFromSexp(p); p = CDR(p);
+	CallTimer timer = CallStats::start();
+
+	// 2 - The arguments are converted before the call leaves the R thread
+	CallBuffers* buffers = acquireBuffers();
+	int32_t argsSize = 0;
+	int64_t* args = readParametersFromSexp(p, argsSize, buffers);
+	int64_t* argsData = buffers->argsData.data();
+
+	int32_t handle;
+	bool isOk = callStaticMethodAsync(typeName, methodName, args, argsData, argsSize, &handle);
+	int64_t argsBytes = buffers->argsBytes;
+	releaseBuffers(buffers);
+
+	if (!isOk)
+	{
+		CallStats::stop(timer, "CallStaticMethodAsync", typeName, methodName, argsBytes, NULL, false);
+		Rf_error(getLastError());
+		return R_NilValue;
+	}
+
+	// 3 - The call is measured until it's awaited
+	AsyncCallInfo info = { "CallStaticMethodAsync", typeName, methodName, timer, argsBytes, argsSize + 1 };
+	return wrapFuture(handle, info);
+}
+
+SEXP ClrHost::rCallMethodAsync(SEXP p)
+{
+	// 1 - Get data from SEXP
+	p = CDR(p); // Skip the first parameter because of function name
+	int64_t objectPtr = readObjectPtrFromSexp(p); p = CDR(p);
+	const char* methodName = readStringFromSexp(p); p = CDR(p);
+	CallTimer timer = CallStats::start();
+
+	// 2 - The arguments are converted before the call leaves the R thread
+	CallBuffers* buffers = acquireBuffers();
+	int32_t argsSize = 0;
+	int64_t* args = readParametersFromSexp(p, argsSize, buffers);
+	int64_t* argsData = buffers->argsData.data();
+
+	int32_t handle;
+	bool isOk = callMethodAsync(objectPtr, methodName, args, argsData, argsSize, &handle);
+	int64_t argsBytes = buffers->argsBytes;
+	releaseBuffers(buffers);
+
+	if (!isOk)
+	{
+		CallStats::stop(timer, "CallMethodAsync", NULL, methodName, argsBytes, NULL, false);
+		Rf_error(getLastError());
+		return R_NilValue;
+	}
+
+	// 3 - The call is measured until it's awaited
+	AsyncCallInfo info = { "CallMethodAsync", "", methodName, timer, argsBytes, argsSize + 1 };
+	return wrapFuture(handle, info);
+}
+
+SEXP ClrHost::rWaitCall(SEXP p)
+{
+	// 1 - Get data from SEXP
+	p = CDR(p); // Skip the first parameter because of function name
+	int32_t handle;
+	readFutureFromSexp(p, handle); p = CDR(p);
+	int32_t timeout = readCountFromSexp(p);
+
+	// Already awaited
+	if (_asyncCalls.find(handle) == _asyncCalls.end())
+		return Rf_ScalarLogical(1);
+
+	// 2 - Wait on the clr runtime, the results stay there until the call is awaited
+	int32_t completed = 0;
+	if (!waitCall(handle, timeout, &completed))
+		Rf_error(getLastError());
+
+	return Rf_ScalarLogical(completed);
+}
+
+SEXP ClrHost::rAwaitCall(SEXP p)
+{
+	// 1 - Get data from SEXP
+	p = CDR(p); // Skip the first parameter because of function name
+	int32_t handle;
+	SEXP future = readFutureFromSexp(p, handle);
+
+	// An awaited future keeps its results
+	std::unordered_map<int32_t, AsyncCallInfo>::iterator it = _asyncCalls.find(handle);
+	if (it == _asyncCalls.end())
+	{
+		SEXP awaited = R_ExternalPtrProtected(future);
+		if (awaited == R_NilValue)
+			error("[ERROR] rAwaitCall: the async call has already failed\n");
+		return awaited;
+	}
 
-	if (!setProperty(objectPtr, propertyName, value))
+	AsyncCallInfo info = it->second;
+	_asyncCalls.erase(it);
+
+	// 2 - Get the results once the call completes, they are converted on the R thread
+	CallBuffers* buffers = acquireBuffers();
+	int64_t* results = reserveResults(info.resultsCapacity, buffers->results);
+	int32_t resultsSize = 0;
+	size_t allocatedCount = allocatedVectors.size();
+	bool isOk = awaitCall(handle, results, info.resultsCapacity, &resultsSize);
+
+	if (!isOk)
+	{
+		CallStats::stop(info.timer, info.entryPoint.c_str(), info.typeName.c_str(), info.memberName.c_str(), info.argsBytes, NULL, false);
+		releaseBuffers(buffers);
+		releaseAllocatedVectors(allocatedCount);
 		Rf_error(getLastError());
+		return R_NilValue;
+	}
+
+	// 3 - Convert and return the result
+	SEXP sexp = PROTECT(wrapResultsOrRelease(results, resultsSize, buffers, allocatedCount));
+	CallStats::stop(info.timer, info.entryPoint.c_str(), info.typeName.c_str(), info.memberName.c_str(), info.argsBytes, sexp, true);
+	releaseBuffers(buffers);
+	releaseAllocatedVectors(allocatedCount); // Now referenced by the returned list
+	R_SetExternalPtrProtected(future, sexp);
+	UNPROTECT(1);
+	return sexp;
+}
+
+SEXP ClrHost::rThenCall(SEXP p)
+{
+	// 1 - Get data from SEXP
+	p = CDR(p); // Skip the first parameter because of function name
+	int32_t handle;
+	SEXP future = readFutureFromSexp(p, handle); p = CDR(p);
+	SEXP callback = CAR(p);
+	if (!Rf_isFunction(callback))
+		error("[ERROR] rThenCall: need a function as callback\n");
+
+	// 2 - The future stays alive until its callback runs
+	SEXP completion = PROTECT(Rf_allocVector(VECSXP, 2));
+	SET_VECTOR_ELT(completion, 0, future);
+	SET_VECTOR_ELT(completion, 1, callback);
+	R_PreserveObject(completion);
+	UNPROTECT(1);
+
+	std::unordered_map<int32_t, SEXP>::iterator it = _completionCallbacks.find(handle);
+	if (it != _completionCallbacks.end())
+	{
+		R_ReleaseObject(it->second);
+		it->second = completion;
+	}
+	else _completionCallbacks[handle] = completion;
+
+	// 3 - The completion of a call which already completed may have been drained, so it's queued again
+	int32_t completed = 1;
+	if (_asyncCalls.find(handle) != _asyncCalls.end() && !waitCall(handle, 0, &completed))
+		Rf_error(getLastError());
+	if (completed)
+		CompletionQueue::push(handle);
+
+	return R_NilValue;
+}
+
+void ClrHost::runCompletedCalls()
+{
+	std::vector<int32_t> handles;
+	CompletionQueue::popAll(handles);
+
+	for (size_t i = 0; i < handles.size(); i++)
+	{
+		std::unordered_map<int32_t, SEXP>::iterator it = _completionCallbacks.find(handles[i]);
+		if (it == _completionCallbacks.end()) continue;
+
+		SEXP completion = it->second;
+		_completionCallbacks.erase(it);
+
+		// The callback errors are printed by R, they don't stop the other callbacks
+		int hasError = 0;
+		SEXP call = PROTECT(Rf_lang2(VECTOR_ELT(completion, 1), VECTOR_ELT(completion, 0)));
+		R_tryEval(call, R_GlobalEnv, &hasError);
+		UNPROTECT(1);
+		R_ReleaseObject(completion);
+	}
+}
+
+/*static*/ void ClrHost::callCompleted(int32_t handle)
+{
+	CompletionQueue::push(handle);
+}
+
+/*static*/ void ClrHost::onCallsCompleted(void* host)
+{
+	((ClrHost*)host)->runCompletedCalls();
+}
+
+void ClrHost::clearAsyncCalls()
+{
+	_asyncCalls.clear();
+	for (std::unordered_map<int32_t, SEXP>::iterator it = _completionCallbacks.begin(); it != _completionCallbacks.end(); ++it)
+		R_ReleaseObject(it->second);
+	_completionCallbacks.clear();
+
+	std::vector<int32_t> handles;
+	CompletionQueue::popAll(handles);
+}
+
+SEXP ClrHost::wrapFuture(int32_t handle, const AsyncCallInfo& info)
+{
+	_asyncCalls[handle] = info;
+
+	// The future knows its host to release the call if R drops it before awaiting
+	SEXP tag = PROTECT(Rf_ScalarInteger(handle));
+	SEXP future = PROTECT(R_MakeExternalPtr(this, tag, R_NilValue));
+	R_RegisterCFinalizerEx(future, ClrHost::finalizeFuture, (Rboolean)1);
+	UNPROTECT(2);
+	return future;
+}
+
+SEXP ClrHost::readFutureFromSexp(SEXP p, int32_t& handle)
+{
+	SEXP e = CAR(p);
+	if (TYPEOF(e) != EXTPTRSXP || R_ExternalPtrAddr(e) != this || TYPEOF(R_ExternalPtrTag(e)) != INTSXP)
+		error("[ERROR] ReadFutureFromSexp: need a future returned by netCallAsync or netCallStaticAsync\n");
+
+	handle = INTEGER(R_ExternalPtrTag(e))[0];
+	return e;
+}
+
+/*static*/ void ClrHost::finalizeFuture(SEXP future)
+{
+	ClrHost* host = (ClrHost*)R_ExternalPtrAddr(future);
+	if (host == NULL || TYPEOF(R_ExternalPtrTag(future)) != INTSXP) return;
+
+	int32_t handle = INTEGER(R_ExternalPtrTag(future))[0];
+	if (host->_asyncCalls.erase(handle) > 0)
+		host->releaseCall(handle);
+	R_ClearExternalPtr(future);
 }
 
 char * ClrHost::readStringFromSexp(SEXP p)
@@ -164,25 +711,254 @@ char * ClrHost::readStringFromSexp(SEXP p)
 	return (char*)CHAR(STRING_ELT(e, 0));
 }
 
-int64_t* ClrHost::readParametersFromSexp(SEXP p, int32_t& length)
+struct AllocVectorArgs
+{
+	SEXPTYPE type;
+	R_xlen_t length;
+	SEXP result;
+};
+
+static void allocPreservedVector(void* p)
+{
+	AllocVectorArgs* args = (AllocVectorArgs*)p;
+	args->result = Rf_allocVector(args->type, args->length);
+	R_PreserveObject(args->result);
+}
+
+/*static*/ int64_t ClrHost::allocVector(int32_t type, int64_t length, void** data)
+{
+	*data = NULL;
+	if ((type != REALSXP && type != INTSXP && type != LGLSXP) || length < 0)
+		return 0;
+
+	// An R error can't jump over the managed frames, so the allocation is isolated
+	AllocVectorArgs args = { (SEXPTYPE)type, (R_xlen_t)length, R_NilValue };
+	if (!R_ToplevelExec(allocPreservedVector, &args))
+		return 0;
+
+	allocatedVectors.push_back(args.result);
+	*data = readDataPtrFromSexp(args.result);
+	return (int64_t)args.result;
+}
+
+struct AllocArrowBatchArgs
+{
+	ArrowSchema* schema;
+	ArrowArray* array;
+	SEXP result;
+};
+
+static void allocPreservedArrowBatch(void* p)
+{
+	AllocArrowBatchArgs* args = (AllocArrowBatchArgs*)p;
+	args->result = ArrowBatch::alloc(&args->schema, &args->array);
+	R_PreserveObject(args->result);
+}
+
+/*static*/ int64_t ClrHost::allocArrowBatch(void** schema, void** array)
+{
+	*schema = NULL;
+	*array = NULL;
+
+	AllocArrowBatchArgs args = { NULL, NULL, R_NilValue };
+	if (!R_ToplevelExec(allocPreservedArrowBatch, &args))
+		return 0;
+
+	allocatedVectors.push_back(args.result);
+	*schema = args.schema;
+	*array = args.array;
+	return (int64_t)args.result;
+}
+
+/*static*/ void ClrHost::releaseAllocatedVectors(size_t count)
+{
+	// Only the vectors allocated after count, because a nested call releases its own vectors only
+	while (allocatedVectors.size() > count)
+	{
+		R_ReleaseObject(allocatedVectors.back());
+		allocatedVectors.pop_back();
+	}
+}
+
+CallBuffers* ClrHost::acquireBuffers()
+{
+	// The buffers are already used by a call in progress, which means that .Net called back R. 
+	// Give dedicated buffers to this nested call to keep the caller ones untouched.
+	if (_buffersInUse)
+		return new CallBuffers();
+
+	// A safe point, no .Net call is in progress
+	releaseDeferredObjects();
+
+	_buffersInUse = true;
+	return &_buffers;
+}
+
+void ClrHost::releaseBuffers(CallBuffers* buffers)
+{
+	// The arrow arguments which .Net didn't import are released with the call
+	for (size_t i = 0; i < buffers->arrowBatches.size(); i++)
+	{
+		ArrowBatch::release(buffers->arrowBatches[i]);
+		R_ReleaseObject(buffers->arrowBatches[i]);
+	}
+	buffers->arrowBatches.clear();
+
+	if (buffers == &_buffers)
+		_buffersInUse = false;
+	else delete buffers;
+}
+
+int64_t* ClrHost::readParametersFromSexp(SEXP p, int32_t& length, CallBuffers* buffers)
 {
 	length = Rf_length(p);
+	buffers->argsBytes = 0;
 	if (length == 0) {
 		return NULL;
 	}
 
-	int64_t* result = new int64_t[length];
+	// The buffers only grow, so they stop allocating once they fit the largest call
+	if (buffers->args.size() < (size_t)length)
+		buffers->args.resize(length);
+	if (buffers->argsData.size() < (size_t)(2 * length))
+		buffers->argsData.resize(2 * length);
+	int64_t* result = buffers->args.data();
+	int64_t* data = buffers->argsData.data();
+	buffers->columnsData.clear();
+	bool hasFrames = false;
 
 	int32_t i;
 	SEXP el;
 	for (i = 0; i < length && p != R_NilValue; i++, p = CDR(p)) {
 		el = CAR(p);
 		result[i] = (int64_t)el;
+
+		if (TYPEOF(el) == ENVSXP && Rf_inherits(el, "ArrowTabular"))
+		{
+			// An arrow RecordBatch or Table is given through the Arrow C data interface, which .Net imports without any copy
+			SEXP batch = ArrowBatch::exportFromR(el);
+			if (batch == R_NilValue)
+			{
+				releaseBuffers(buffers);
+				Rf_error("Unable to export the arrow argument %d\n", i + 1);
+			}
+			R_PreserveObject(batch);
+			buffers->arrowBatches.push_back(batch);
+
+			result[i] = (int64_t)batch;
+			data[2 * i] = 0;
+			data[2 * i + 1] = 0;
+		}
+		else if (Rf_isFrame(el))
+		{
+			// A data.frame gives the memory of its columns, its length is minus its number of columns.
+			// Its data is the offset of its columns in their buffer, turned into a pointer once the buffer stops growing.
+			R_xlen_t columns = XLENGTH(el);
+			data[2 * i] = columns == 0 ? 0 : (int64_t)buffers->columnsData.size();
+			data[2 * i + 1] = -(int64_t)columns;
+			for (R_xlen_t j = 0; j < columns; j++)
+			{
+				SEXP column = VECTOR_ELT(el, j);
+				void* columnData = readDataPtrFromSexp(column);
+				buffers->columnsData.push_back((int64_t)columnData);
+				buffers->columnsData.push_back(columnData == NULL ? 0 : (int64_t)XLENGTH(column));
+			}
+			hasFrames = hasFrames || columns > 0;
+		}
+		else
+		{
+			// Give direct access to the vector memory, so .Net can bind it without any copy.
+			// The arguments belong to the .External call, so they stay protected until the call returns.
+			data[2 * i] = (int64_t)readDataPtrFromSexp(el);
+			data[2 * i + 1] = data[2 * i] == 0 ? 0 : (int64_t)XLENGTH(el);
+		}
+
+		if (CallStats::enabled)
+			buffers->argsBytes += CallStats::sizeOf(el);
+	}
+
+	if (hasFrames)
+	{
+		for (i = 0; i < length; i++)
+		{
+			if (data[2 * i + 1] < 0)
+				data[2 * i] = (int64_t)(buffers->columnsData.data() + data[2 * i]);
+		}
 	}
 
 	return result;
 }
 
+/*static*/ void* ClrHost::readDataPtrFromSexp(SEXP e)
+{
+	// Only a vector has a length, a .Net object, NULL or an environment gives no memory
+	switch (TYPEOF(e))
+	{
+	case REALSXP:
+		return XLENGTH(e) > INT_MAX ? NULL : REAL(e); // Too large for a .Net span
+	case INTSXP:
+		return XLENGTH(e) > INT_MAX ? NULL : INTEGER(e);
+	case LGLSXP:
+		return XLENGTH(e) > INT_MAX ? NULL : LOGICAL(e);
+	case STRSXP:
+		if (XLENGTH(e) > INT_MAX)
+			return NULL;
+		// The CHARSXP pointers, which .Net decodes once through its strings cache.
+		// A deferred ALTREP vector isn't materialized, .Net reads its elements one by one instead.
+#if defined(R_VERSION) && R_VERSION >= R_Version(3, 5, 0)
+		return ALTREP(e) ? NULL : (void*)STRING_PTR_RO(e);
+#else
+		return (void*)STRING_PTR(e);
+#endif
+	default:
+		return NULL;
+	}
+}
+
+int64_t* ClrHost::reserveResults(int32_t capacity, std::vector<int64_t>& buffer)
+{
+	if (buffer.size() < (size_t)capacity)
+		buffer.resize(capacity);
+
+	return buffer.data();
+}
+
+int32_t ClrHost::readHandleFromSexp(SEXP p) {
+	SEXP e = CAR(p);
+
+	if (TYPEOF(e) != INTSXP || LENGTH(e) != 1)
+	{
+		error("[ERROR] ReadHandleFromSexp: cannot parse a call site handle from SEXP: need an INTSXP of length 1\n");
+		return -1;
+	}
+
+	return INTEGER(e)[0];
+}
+
+int32_t ClrHost::readCountFromSexp(SEXP p) {
+	SEXP e = CAR(p);
+
+	if (TYPEOF(e) != INTSXP || LENGTH(e) != 1 || INTEGER(e)[0] < 0)
+	{
+		error("[ERROR] ReadCountFromSexp: cannot parse a count from SEXP: need a positive INTSXP of length 1\n");
+		return 0;
+	}
+
+	return INTEGER(e)[0];
+}
+
+int32_t ClrHost::readFlagFromSexp(SEXP p) {
+	SEXP e = CAR(p);
+
+	if (TYPEOF(e) != LGLSXP || LENGTH(e) != 1 || LOGICAL(e)[0] == NA_LOGICAL)
+	{
+		error("[ERROR] ReadFlagFromSexp: cannot parse a flag from SEXP: need a LGLSXP of length 1 which isn't NA\n");
+		return 0;
+	}
+
+	return LOGICAL(e)[0];
+}
+
 int64_t ClrHost::readObjectPtrFromSexp(SEXP p) {
 	SEXP e = CAR(p);
 
@@ -197,21 +973,116 @@ int64_t ClrHost::readObjectPtrFromSexp(SEXP p) {
 
 SEXP ClrHost::WrapResults(int64_t* results, int32_t length)
 {
-	SEXP list = Rf_allocVector(VECSXP, length);
+	// Protected because an arrow result is imported by R code
+	SEXP list = PROTECT(Rf_allocVector(VECSXP, length));
 
 	for (int32_t i = 0; i < length; i++)
 		SET_VECTOR_ELT(list, i, WrapResult(results[i]));
 
+	UNPROTECT(1);
 	return list;
 }
 
+struct WrapResultsArgs
+{
+	ClrHost* host;
+	bool isBatch;
+	int64_t* results;
+	int32_t length;
+	CallBuffers* buffers;
+	size_t allocatedCount;
+};
+
+/*static*/ SEXP ClrHost::wrapResultsCallback(void* p)
+{
+	WrapResultsArgs* args = (WrapResultsArgs*)p;
+	return args->isBatch
+		? args->host->WrapBatchResult(args->results[0])
+		: args->host->WrapResults(args->results, args->length);
+}
+
+/*static*/ void ClrHost::releaseCallCallback(void* p, Rboolean jump)
+{
+	// Only on an error, otherwise the caller still reads the buffers before releasing them
+	if (!jump) return;
+	WrapResultsArgs* args = (WrapResultsArgs*)p;
+	if (args->buffers != NULL)
+		args->host->releaseBuffers(args->buffers);
+	releaseAllocatedVectors(args->allocatedCount);
+}
+
+/*static*/ SEXP ClrHost::unwindProtectWrap(void* args)
+{
+#if defined(R_VERSION) && R_VERSION >= R_Version(3, 5, 0)
+	// An allocation failure or a warning turned into an error would jump over the release of the buffers,
+	// which would then stay in use for the rest of the session, and over the release of the allocated vectors.
+	static SEXP token = NULL;
+	if (token == NULL)
+	{
+		token = R_MakeUnwindCont();
+		R_PreserveObject(token);
+	}
+
+	SEXP sexp = R_UnwindProtect(wrapResultsCallback, args, releaseCallCallback, args, token);
+	SETCAR(token, R_NilValue);
+	return sexp;
+#else
+	return wrapResultsCallback(args);
+#endif
+}
+
+SEXP ClrHost::wrapResultsOrRelease(int64_t* results, int32_t length, CallBuffers* buffers, size_t allocatedCount)
+{
+	WrapResultsArgs args = { this, false, results, length, buffers, allocatedCount };
+	return unwindProtectWrap(&args);
+}
+
+SEXP ClrHost::wrapBatchResultOrRelease(int64_t result, size_t allocatedCount)
+{
+	// The batch calls have already released their buffers
+	WrapResultsArgs args = { this, true, &result, 1, NULL, allocatedCount };
+	return unwindProtectWrap(&args);
+}
+
 SEXP ClrHost::WrapResult(int64_t result)
 {
 	SEXP sexp = result == 0 ? R_NilValue : (SEXP)result;
 
+	if (ArrowBatch::is(sexp))
+	{
+		// Still preserved by the call, until R moves it into an arrow RecordBatch
+		SEXP batch = ArrowBatch::importToR(sexp);
+		if (batch == R_NilValue)
+			Rf_warning("Unable to import the arrow RecordBatch returned by .Net\n");
+		return batch;
+	}
+
 	if (TYPEOF(sexp) == EXTPTRSXP)
+	{
 		registerFinalizer(sexp);
+		CallStats::objectCreated();
+	}
+
+	return sexp;
+}
+
+SEXP ClrHost::WrapBatchResult(int64_t result)
+{
+	SEXP sexp = PROTECT(WrapResult(result));
+
+	// The results which aren't simplified come as a list which can hold .net objects and arrow batches
+	if (TYPEOF(sexp) == VECSXP)
+	{
+		R_xlen_t length = XLENGTH(sexp);
+		for (R_xlen_t i = 0; i < length; i++)
+		{
+			SEXP item = VECTOR_ELT(sexp, i);
+			if (TYPEOF(item) == EXTPTRSXP)
+				SET_VECTOR_ELT(sexp, i, WrapResult((int64_t)item));
+		}
+	}
 
+	UNPROTECT(1);
 	return sexp;
 }
 
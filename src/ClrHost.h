@@ -3,10 +3,12 @@
 
 #include <string>
 #include <stdint.h>
+#include <climits>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <vector>
 #include <algorithm>
+#include <unordered_map>
 
 // Check if its windows
 #ifdef _WIN32
@@ -53,6 +55,43 @@
 
 #include <R.h>
 #include <Rinternals.h>
+#include <Rversion.h>
+
+#include "ArrowBatch.h"
+#include "CallStats.h"
+#include "RuntimeConfig.h"
+
+// Arguments and results buffers exchanged with the CLR.
+// They are owned by the host and reused between calls to avoid any heap allocation per call.
+struct CallBuffers
+{
+	std::vector<int64_t> args;
+	std::vector<int64_t> argsData; // Data pointer and length pairs of the numeric, integer, logical and character arguments
+	std::vector<int64_t> columnsData; // Data pointer and length pairs of the data.frame arguments columns
+	std::vector<int64_t> results;
+	std::vector<SEXP> arrowBatches; // The arrow arguments exported for the call, preserved until it returns
+	int64_t argsBytes; // Size of the arguments data, only counted when the call stats are enabled
+};
+
+// The kinds of the scalars exchanged with a prepared method without any converter, as numbered by .Net.
+#define SCALAR_VOID 0
+#define SCALAR_DOUBLE 1
+#define SCALAR_INTEGER 2
+#define SCALAR_LOGICAL 3
+
+// The most arguments read as raw scalars, a method which takes more is called through the converters.
+#define MAX_SCALAR_ARGS 16
+
+// A call running on the .Net thread pool, which R knows through a future.
+struct AsyncCallInfo
+{
+	std::string entryPoint;
+	std::string typeName;
+	std::string memberName;
+	CallTimer timer;
+	int64_t argsBytes;
+	int32_t resultsCapacity;
+};
 
 class ClrHost
 {
@@ -62,7 +101,7 @@ public:
 
 	unsigned int getDomainId() { return _domainId; }
 
-	virtual void start(const char* app_base_dir, const char* package_bin_folder, const char* dotnet_install_path) = 0;
+	virtual void start(const char* app_base_dir, const char* package_bin_folder, const char* dotnet_install_path, const char* tpa_manifest_folder, const RuntimeConfig& config) = 0;
 	virtual void shutdown() = 0;
 
 	void rloadAssembly(char** filePath);
@@ -75,27 +114,111 @@ public:
 	SEXP rGetProperty(SEXP p);
 	void rSetProperty(SEXP p);
 
+	SEXP rPrepareMethod(SEXP p);
+	SEXP rCallPreparedMethod(SEXP p);
+
+	SEXP rCallStaticMethodBatch(SEXP p);
+	SEXP rCallMethodBatch(SEXP p);
+
+	SEXP rCallStaticMethodAsync(SEXP p);
+	SEXP rCallMethodAsync(SEXP p);
+	SEXP rWaitCall(SEXP p);
+	SEXP rAwaitCall(SEXP p);
+	SEXP rThenCall(SEXP p);
+	void runCompletedCalls();
+
+	// Callback given to .Net to allocate an R vector which .Net fills in place, instead of copying a .Net array.
+	// The vector is preserved from the R garbage collector until the call which allocated it returns.
+	static int64_t allocVector(int32_t type, int64_t length, void** data);
+
+	// Callback given to .Net to export a record batch through the Arrow C data interface, R then imports it without any copy.
+	// The structs are preserved from the R garbage collector until the call which allocated them returns.
+	static int64_t allocArrowBatch(void** schema, void** array);
+
+	// Callback given to .Net to notify an async call completion, it's called from a .Net thread so it doesn't use the R API.
+	static void callCompleted(int32_t handle);
+
+	// Runs the completed calls callbacks, called from the R event loop.
+	static void onCallsCompleted(void* host);
+
 protected:
 	unsigned int _domainId;
 
 	virtual const char* getLastError() = 0;
 	virtual bool loadAssembly(const char* filePath) = 0;
-	virtual bool callStaticMethod(const char* typeName, const char* methodName, int64_t* args, int32_t argsSize, int64_t** results, int32_t* resultsSize) = 0;
+	virtual bool callStaticMethod(const char* typeName, const char* methodName, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize) = 0;
 	virtual bool getStaticProperty(const char* typeName, const char* propertyName, int64_t* value) = 0;
 	virtual bool setStaticProperty(const char* typeName, const char* propertyName, int64_t value) = 0;
 	
-	virtual bool createObject(const char* typeName, int64_t* args, int32_t argsSize, int64_t* value) = 0;
+	virtual bool createObject(const char* typeName, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* value) = 0;
 	virtual void registerFinalizer(SEXP sexp) = 0;
-	virtual bool callMethod(int64_t objectPtr, const char* methodName, int64_t* args, int32_t argsSize, int64_t** results, int32_t* resultsSize) = 0;
+	// Releases the .Net objects collected by R since the last call, called when a call from R starts.
+	virtual void releaseDeferredObjects() = 0;
+	virtual bool callMethod(int64_t objectPtr, const char* methodName, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize) = 0;
 	virtual bool getProperty(int64_t objectPtr, const char* propertyName, int64_t* value) = 0;
 	virtual bool setProperty(int64_t objectPtr, const char* propertyName, int64_t value) = 0;
+
+	virtual bool prepareMethod(const char* typeName, int64_t objectPtr, int32_t isStatic, const char* methodName, const char** argTypes, int32_t argTypesSize, int32_t* handle) = 0;
+	virtual bool callPreparedMethod(int32_t handle, int64_t objectPtr, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize) = 0;
+	virtual bool getScalarSignature(int32_t handle, int32_t* kinds, int32_t capacity, int32_t* size) = 0;
+	virtual bool callPreparedScalar(int32_t handle, int64_t objectPtr, int64_t* args, int32_t argsSize, void* result) = 0;
+
+	virtual bool callStaticMethodBatch(const char* typeName, const char* methodName, int32_t count, int32_t simplify, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* result) = 0;
+	virtual bool callMethodBatch(int64_t objectsPtr, const char* methodName, int32_t count, int32_t simplify, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* result) = 0;
+
+	virtual bool callStaticMethodAsync(const char* typeName, const char* methodName, int64_t* args, int64_t* argsData, int32_t argsSize, int32_t* handle) = 0;
+	virtual bool callMethodAsync(int64_t objectPtr, const char* methodName, int64_t* args, int64_t* argsData, int32_t argsSize, int32_t* handle) = 0;
+	virtual bool waitCall(int32_t handle, int32_t timeout, int32_t* completed) = 0;
+	virtual bool awaitCall(int32_t handle, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize) = 0;
+	virtual bool releaseCall(int32_t handle) = 0;
+
+	// Forgets the calls in flight, i.e. when the CLR shuts down
+	void clearAsyncCalls();
+	// Forgets the scalar signatures of the prepared methods, i.e. when the CLR shuts down
+	void clearScalarSignatures() { _scalarSignatures.clear(); }
 private:
 
+	// The calls in flight by handle, until R awaits them or releases their future
+	std::unordered_map<int32_t, AsyncCallInfo> _asyncCalls;
+	// The R callbacks to run once the calls complete by handle, each one is a preserved list of the future and its callback
+	std::unordered_map<int32_t, SEXP> _completionCallbacks;
+
+	SEXP wrapFuture(int32_t handle, const AsyncCallInfo& info);
+	SEXP readFutureFromSexp(SEXP p, int32_t& handle);
+	static void finalizeFuture(SEXP future);
+
+	// The kinds of the prepared methods which only take and return scalars by handle, the returned one first.
+	// Empty for the other methods.
+	std::vector<std::vector<int32_t> > _scalarSignatures;
+	bool tryCallPreparedScalar(int32_t handle, int64_t objectPtr, SEXP p, const CallTimer& timer, SEXP& result);
+
+	// Set while the CLR works with _buffers, a nested call (.Net calling back R) then uses its own buffers.
+	bool _buffersInUse;
+	CallBuffers _buffers;
+
+	static std::vector<SEXP> allocatedVectors;
+	static void releaseAllocatedVectors(size_t count);
+
+	CallBuffers* acquireBuffers();
+	void releaseBuffers(CallBuffers* buffers);
+	// Converts the results, the buffers and the allocated vectors are released if R raises an error meanwhile
+	SEXP wrapResultsOrRelease(int64_t* results, int32_t length, CallBuffers* buffers, size_t allocatedCount);
+	SEXP wrapBatchResultOrRelease(int64_t result, size_t allocatedCount);
+	static SEXP unwindProtectWrap(void* args);
+	static SEXP wrapResultsCallback(void* p);
+	static void releaseCallCallback(void* p, Rboolean jump);
+
 	char* readStringFromSexp(SEXP p);
-	int64_t* readParametersFromSexp(SEXP p, int32_t& length);
+	int64_t* readParametersFromSexp(SEXP p, int32_t& length, CallBuffers* buffers);
+	static void* readDataPtrFromSexp(SEXP e);
+	int64_t* reserveResults(int32_t capacity, std::vector<int64_t>& buffer);
 	SEXP WrapResults(int64_t* results, int32_t length);
 	SEXP WrapResult(int64_t result);
+	SEXP WrapBatchResult(int64_t result);
 	int64_t readObjectPtrFromSexp(SEXP p);
+	int32_t readHandleFromSexp(SEXP p);
+	int32_t readCountFromSexp(SEXP p);
+	int32_t readFlagFromSexp(SEXP p);
 };
 
 bool file_exists(const char* path);
@@ -0,0 +1,89 @@
+#include "CompletionQueue.h"
+#include "ClrHost.h"
+
+#if !WINDOWS
+#include <fcntl.h>
+#include <unistd.h>
+#include <R_ext/eventloop.h>
+#endif
+
+// Identifies the input handler among the R ones
+#define COMPLETION_QUEUE_ACTIVITY 42
+
+std::mutex CompletionQueue::mutex;
+std::vector<int32_t> CompletionQueue::handles;
+int CompletionQueue::fds[2] = { -1, -1 };
+void* CompletionQueue::handler = NULL;
+
+/*static*/ void CompletionQueue::install(Drain drain, void* data)
+{
+#if !WINDOWS
+	if (handler != NULL) return;
+	if (pipe(fds) != 0)
+	{
+		fds[0] = fds[1] = -1;
+		return;
+	}
+
+	// A notification is never worth blocking a .Net thread
+	fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+	fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+
+	InputHandler* inputHandler = addInputHandler(R_InputHandlers, fds[0], drain, COMPLETION_QUEUE_ACTIVITY);
+	inputHandler->userData = data;
+	handler = inputHandler;
+#endif
+}
+
+/*static*/ void CompletionQueue::uninstall()
+{
+#if !WINDOWS
+	if (handler == NULL) return;
+
+	removeInputHandler(&R_InputHandlers, (InputHandler*)handler);
+	handler = NULL;
+
+	// A .Net thread still completing a call could write to a closed, or even reused, file descriptor
+	std::lock_guard<std::mutex> lock(mutex);
+	close(fds[0]);
+	close(fds[1]);
+	fds[0] = fds[1] = -1;
+#endif
+}
+
+/*static*/ void CompletionQueue::push(int32_t handle)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	bool wasEmpty = handles.empty();
+	handles.push_back(handle);
+
+#if !WINDOWS
+	// Only the first handle wakes up R, the next ones are drained with it.
+	// The write is non blocking, so it can stay under the lock which keeps the pipe open.
+	if (wasEmpty && fds[1] >= 0)
+	{
+		char signal = 1;
+		ssize_t written = write(fds[1], &signal, 1);
+		(void)written;
+	}
+#else
+	(void)wasEmpty;
+#endif
+}
+
+/*static*/ void CompletionQueue::popAll(std::vector<int32_t>& result)
+{
+#if !WINDOWS
+	// Consumes the wake up signals before the handles, so a handle pushed meanwhile signals again.
+	// The read end is only closed by uninstall, from the R thread as well.
+	if (fds[0] >= 0)
+	{
+		char signals[64];
+		while (read(fds[0], signals, sizeof(signals)) > 0);
+	}
+#endif
+
+	result.clear();
+	std::lock_guard<std::mutex> lock(mutex);
+	result.swap(handles);
+}
@@ -0,0 +1,33 @@
+#ifndef __COMPLETION_QUEUE_H__
+#define __COMPLETION_QUEUE_H__
+
+#include <stdint.h>
+#include <mutex>
+#include <vector>
+
+// Handles of the async calls completed on the .Net threads, which the R main thread drains.
+// The .Net threads only push a handle, they never use the R API. On Unix an input handler wakes up
+// the R event loop once handles are pushed, on Windows the queue is drained when R polls or awaits a future.
+class CompletionQueue
+{
+public:
+	typedef void (*Drain)(void* data);
+
+	// Registers the function called from the R event loop once handles are pushed.
+	static void install(Drain drain, void* data);
+	static void uninstall();
+
+	// Called from any thread, with the handle of a completed call.
+	static void push(int32_t handle);
+
+	// Takes all the pushed handles, from the R thread.
+	static void popAll(std::vector<int32_t>& handles);
+
+private:
+	static std::mutex mutex;
+	static std::vector<int32_t> handles;
+	static int fds[2];
+	static void* handler;
+};
+
+#endif // !__COMPLETION_QUEUE_H__
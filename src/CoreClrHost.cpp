@@ -1,6 +1,17 @@
 #include "CoreClrHost.h"
+#include "CompletionQueue.h"
+#include "TpaManifest.h"
 
-releaseObject_ptr CoreClrHost::releaseObjectFunc;
+#include <chrono>
+
+releaseObjects_ptr CoreClrHost::releaseObjectsFunc;
+releaseObjectsUnmanaged_ptr CoreClrHost::releaseObjectsUnmanaged;
+std::vector<int64_t> CoreClrHost::releasedObjects;
+
+static double elapsed_ms(const std::chrono::steady_clock::time_point& start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
 
 CoreClrHost::CoreClrHost()
 {
@@ -12,8 +23,10 @@ CoreClrHost::~CoreClrHost()
 }
 
 
-void CoreClrHost::start(const char* app_base_dir, const char* package_bin_folder, const char* dotnet_install_path)
+void CoreClrHost::start(const char* app_base_dir, const char* package_bin_folder, const char* dotnet_install_path, const char* tpa_manifest_folder, const RuntimeConfig& config)
 {
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
 	Rprintf("app_base_dir: %s\n", app_base_dir);
 	Rprintf("package_bin_folder: %s\n", package_bin_folder);
 	Rprintf("dotnet_install_path: %s\n", dotnet_install_path);
@@ -29,12 +42,24 @@ void CoreClrHost::start(const char* app_base_dir, const char* package_bin_folder
 
 	std::string tpa_list;
 	std::string core_clr_path;
-	if (!get_core_clr_with_tpa_list(app_base_dir_exp.c_str(), package_bin_folder, dotnet_install_path, core_clr_path, tpa_list))
+	std::vector<std::string> tpa_directories;
+	tpa_directories.push_back(package_bin_folder == NULL ? "" : package_bin_folder);
+	tpa_directories.push_back(app_base_dir_exp);
+	tpa_directories.push_back(dotnet_install_path == NULL ? "" : dotnet_install_path);
+	TpaManifest manifest(tpa_manifest_folder, tpa_directories);
+
+	bool fromManifest = manifest.load(core_clr_path, tpa_list);
+	if (!fromManifest)
 	{
-		Rf_warning("Please install a dotnet core runtime version first.\nYou can use the install_dotnet_core function as:\n  install_dotnet_core()\n  start_dotnet_core_clr()");
-		return;
+		if (!get_core_clr_with_tpa_list(app_base_dir_exp.c_str(), package_bin_folder, dotnet_install_path, core_clr_path, tpa_list))
+		{
+			Rf_warning("Please install a dotnet core runtime version first.\nYou can use the install_dotnet_core function as:\n  install_dotnet_core()\n  start_dotnet_core_clr()");
+			return;
+		}
+		manifest.save(core_clr_path, tpa_list);
 	}
 	
+	Rprintf("TPA list %s in %.2f ms\n", fromManifest ? "loaded from the manifest" : "built", elapsed_ms(startTime));
 	Rprintf("Load %s from: %s\n", CORECLR_FILE_NAME, core_clr_path.c_str());
 
 	// 1. Load CoreCLR (coreclr.dll/libcoreclr.so)
@@ -80,28 +105,43 @@ void CoreClrHost::start(const char* app_base_dir, const char* package_bin_folder
 	}
 
 	// 3. Construct properties used when starting the runtime
-	// Define CoreCLR properties
-	// Other properties related to assembly loading are common here
-	const char* propertyKeys[] = {
-		"TRUSTED_PLATFORM_ASSEMBLIES"      // Trusted assemblies
-	};
+	// The trusted assemblies are resolved by the host, the other properties come from the runtime config:
+	// GC mode and limits, tiered compilation, probing paths ...
+	std::vector<const char*> propertyKeys;
+	std::vector<const char*> propertyValues;
+	propertyKeys.push_back("TRUSTED_PLATFORM_ASSEMBLIES");
+	propertyValues.push_back(tpa_list.c_str());
+
+	_config = RuntimeConfig();
+	for (size_t i = 0; i < config.size(); i++)
+	{
+		if (config.keys()[i] == "TRUSTED_PLATFORM_ASSEMBLIES")
+		{
+			Rf_warning("TRUSTED_PLATFORM_ASSEMBLIES is resolved by the host, the configured value is ignored");
+			continue;
+		}
+		_config.set(config.keys()[i], config.values()[i]);
+	}
 
-	const char* propertyValues[] = {
-		tpa_list.c_str()
-	};
+	for (size_t i = 0; i < _config.size(); i++)
+	{
+		propertyKeys.push_back(_config.keys()[i].c_str());
+		propertyValues.push_back(_config.values()[i].c_str());
+		Rprintf("%s: %s\n", _config.keys()[i].c_str(), _config.values()[i].c_str());
+	}
 
 	// 4. Start the CoreCLR runtime and create the default (and only) AppDomain
 	int hr = _initializeCoreClr(
 		app_base_dir_exp.c_str(),        // App base path
 		"CoreClrHost",       // AppDomain friendly name
-		sizeof(propertyKeys) / sizeof(char*),   // Property count
-		propertyKeys,       // Property names
-		propertyValues,     // Property values
+		(int)propertyKeys.size(),   // Property count
+		&propertyKeys[0],       // Property names
+		&propertyValues[0],     // Property values
 		&_hostHandle,        // Host handle
 		&_domainId); // AppDomain ID
 
 	if (hr >= 0)
-		Rprintf("CoreCLR started\n");
+		Rprintf("CoreCLR started in %.2f ms\n", elapsed_ms(startTime));
 	else
 	{
 		Rf_error("coreclr_initialize failed - status: 0x%08x\n", hr);
@@ -116,18 +156,51 @@ void CoreClrHost::start(const char* app_base_dir, const char* package_bin_folder
 	createManagedDelegate("SetStaticProperty", (void**)&_setStaticPropertyFunc);
 	createManagedDelegate("CreateObject", (void**)&_createObjectFunc);
 	createManagedDelegate("CallMethod", (void**)&_callFunc);
-	createManagedDelegate("ReleaseObject", (void**)&(CoreClrHost::releaseObjectFunc));
+	createManagedDelegate("ReleaseObjects", (void**)&(CoreClrHost::releaseObjectsFunc));
 	createManagedDelegate("GetProperty", (void**)&_getFunc);
 	createManagedDelegate("SetProperty", (void**)&_setFunc);
+	createManagedDelegate("PrepareMethod", (void**)&_prepareMethodFunc);
+	createManagedDelegate("CallPreparedMethod", (void**)&_callPreparedMethodFunc);
+	createManagedDelegate("GetScalarSignature", (void**)&_getScalarSignatureFunc);
+	createManagedDelegate("CallPreparedScalar", (void**)&_callPreparedScalarFunc);
+	createManagedDelegate("CallStaticMethodBatch", (void**)&_callStaticMethodBatchFunc);
+	createManagedDelegate("CallMethodBatch", (void**)&_callMethodBatchFunc);
+	createManagedDelegate("CallStaticMethodAsync", (void**)&_callStaticMethodAsyncFunc);
+	createManagedDelegate("CallMethodAsync", (void**)&_callMethodAsyncFunc);
+	createManagedDelegate("WaitCall", (void**)&_waitCallFunc);
+	createManagedDelegate("AwaitCall", (void**)&_awaitCallFunc);
+	createManagedDelegate("ReleaseCall", (void**)&_releaseCallFunc);
+
+	bindUnmanagedEntryPoints();
+
+	// 6. Give to managed code the native functions it can call back
+	createManagedDelegate("RegisterNativeCallbacks", (void**)&_registerNativeCallbacksFunc);
+	if (!_registerNativeCallbacksFunc((void*)&ClrHost::allocVector, (void*)&ClrHost::callCompleted, (void*)&ClrHost::allocArrowBatch))
+		Rf_error(getLastError());
+
+	// 7. Resolve the async calls callbacks from the R event loop
+	CompletionQueue::install(&ClrHost::onCallsCompleted, this);
 }
 
 void CoreClrHost::shutdown()
 {
+	// The calls in flight and the prepared methods are lost with the runtime
+	releaseDeferredObjects();
+	// The .Net threads stop signaling their completed calls before the pipe is closed
+	if (_hostHandle != NULL && _registerNativeCallbacksFunc != NULL)
+		_registerNativeCallbacksFunc((void*)&ClrHost::allocVector, NULL, (void*)&ClrHost::allocArrowBatch);
+	CompletionQueue::uninstall();
+	clearAsyncCalls();
+	clearScalarSignatures();
+
 	int hr = _shutdownCoreClr(_hostHandle, _domainId);
 
 	if (hr >= 0)
 	{
 		Rprintf("CoreCLR successfully shutdown\n");
+		releaseObjectsFunc = NULL;
+		releaseObjectsUnmanaged = NULL;
+		_registerNativeCallbacksFunc = NULL;
 		_hostHandle = NULL;
 		_domainId = 0;
 	}
@@ -166,15 +239,16 @@ bool CoreClrHost::loadAssembly(const char * filePath)
 	return _loadAssemblyFunc(filePath);
 }
 
-bool CoreClrHost::callStaticMethod(const char* typeName, const char* methodName, int64_t* args, int32_t argsSize, int64_t** results, int32_t* resultsSize)
+bool CoreClrHost::callStaticMethod(const char* typeName, const char* methodName, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize)
 {
+	// Reported by getLastError once the caller released its buffers, an R error would jump over their release
 	if (_coreClr == NULL && _hostHandle == NULL)
-	{
-		Rf_error("CoreCLR isn't started.");
-		return true;
-	}
+		return false;
 
-	return _callStaticMethodFunc(typeName, methodName, args, argsSize, results, resultsSize);
+	if (_useUnmanagedEntryPoints)
+		return _callStaticMethodUnmanaged(typeName, (int32_t)strlen(typeName), methodName, (int32_t)strlen(methodName), args, argsData, argsSize, results, resultsCapacity, resultsSize) != 0;
+
+	return _callStaticMethodFunc(typeName, methodName, args, argsData, argsSize, results, resultsCapacity, resultsSize);
 }
 
 bool CoreClrHost::getStaticProperty(const char* typeName, const char* propertyName, int64_t* value)
@@ -185,6 +259,9 @@ bool CoreClrHost::getStaticProperty(const char* typeName, const char* propertyNa
 		return true;
 	}
 
+	if (_useUnmanagedEntryPoints)
+		return _getStaticPropertyUnmanaged(typeName, (int32_t)strlen(typeName), propertyName, (int32_t)strlen(propertyName), value) != 0;
+
 	return _getStaticPropertyFunc(typeName, propertyName, value);
 }
 
@@ -196,53 +273,194 @@ bool CoreClrHost::setStaticProperty(const char* typeName, const char* propertyNa
 		return true;
 	}
 
+	if (_useUnmanagedEntryPoints)
+		return _setStaticPropertyUnmanaged(typeName, (int32_t)strlen(typeName), propertyName, (int32_t)strlen(propertyName), value) != 0;
+
 	return _setStaticPropertyFunc(typeName, propertyName, value);
 }
 
-bool CoreClrHost::createObject(const char* typeName, int64_t* args, int32_t argsSize, int64_t* value)
+bool CoreClrHost::createObject(const char* typeName, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* value)
 {
+	if (_coreClr == NULL && _hostHandle == NULL)
+		return false;
+
+	if (_useUnmanagedEntryPoints)
+		return _createObjectUnmanaged(typeName, (int32_t)strlen(typeName), args, argsData, argsSize, value) != 0;
+
+	return _createObjectFunc(typeName, args, argsData, argsSize, value);
+}
+
+void CoreClrHost::registerFinalizer(SEXP sexp)
+{
+	R_RegisterCFinalizerEx(sexp, CoreClrHost::releaseObject, (Rboolean)1);
+}
+
+/*static*/ void CoreClrHost::releaseObject(SEXP sexp)
+{
+	// Only queued, a GC which collects many objects doesn't call .Net for each one
+	void* handle = R_ExternalPtrAddr(sexp);
+	if (handle == NULL) return;
+
+	R_ClearExternalPtr(sexp);
+	releasedObjects.push_back((int64_t)handle);
+	if (releasedObjects.size() >= RELEASE_OBJECTS_BATCH_SIZE)
+		flushReleasedObjects();
+}
+
+void CoreClrHost::releaseDeferredObjects()
+{
+	flushReleasedObjects();
+}
+
+/*static*/ void CoreClrHost::flushReleasedObjects()
+{
+	if (releasedObjects.empty()) return;
+
+	// The objects are gone with the runtime
+	if (releaseObjectsFunc == NULL && releaseObjectsUnmanaged == NULL)
+	{
+		releasedObjects.clear();
+		return;
+	}
+
+	int32_t count = (int32_t)releasedObjects.size();
+	if (releaseObjectsUnmanaged != NULL)
+		releaseObjectsUnmanaged(releasedObjects.data(), count);
+	else releaseObjectsFunc(releasedObjects.data(), count);
+	CallStats::objectsReleased(count);
+	releasedObjects.clear();
+}
+
+bool CoreClrHost::callMethod(int64_t objectPtr, const char* methodName, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize) {
+	if (_coreClr == NULL && _hostHandle == NULL)
+		return false;
+
+	if (_useUnmanagedEntryPoints)
+		return _callMethodUnmanaged(objectPtr, methodName, (int32_t)strlen(methodName), args, argsData, argsSize, results, resultsCapacity, resultsSize) != 0;
+
+	return _callFunc(objectPtr, methodName, args, argsData, argsSize, results, resultsCapacity, resultsSize);
+}
+
+bool CoreClrHost::getProperty(int64_t objectPtr, const char* propertyName, int64_t* value) {
 	if (_coreClr == NULL && _hostHandle == NULL)
 	{
 		Rf_error("CoreCLR isn't started.");
 		return true;
 	}
 
-	return _createObjectFunc(typeName, args, argsSize, value);
+	if (_useUnmanagedEntryPoints)
+		return _getPropertyUnmanaged(objectPtr, propertyName, (int32_t)strlen(propertyName), value) != 0;
+
+	return _getFunc(objectPtr, propertyName, value);
 }
 
-void CoreClrHost::registerFinalizer(SEXP sexp)
-{
-	R_RegisterCFinalizerEx(sexp, [](SEXP p) { CoreClrHost::releaseObjectFunc((int64_t)p); }, (Rboolean)1);
+bool CoreClrHost::setProperty(int64_t objectPtr, const char* propertyName, int64_t value) {
+	if (_coreClr == NULL && _hostHandle == NULL)
+	{
+		Rf_error("CoreCLR isn't started.");
+		return true;
+	}
+
+	if (_useUnmanagedEntryPoints)
+		return _setPropertyUnmanaged(objectPtr, propertyName, (int32_t)strlen(propertyName), value) != 0;
+
+	return _setFunc(objectPtr, propertyName, value);
 }
 
-bool CoreClrHost::callMethod(int64_t objectPtr, const char* methodName, int64_t* args, int32_t argsSize, int64_t** results, int32_t* resultsSize) {
+bool CoreClrHost::prepareMethod(const char* typeName, int64_t objectPtr, int32_t isStatic, const char* methodName, const char** argTypes, int32_t argTypesSize, int32_t* handle) {
 	if (_coreClr == NULL && _hostHandle == NULL)
 	{
 		Rf_error("CoreCLR isn't started.");
 		return true;
 	}
 
-	return _callFunc(objectPtr, methodName, args, argsSize, results, resultsSize);
+	return _prepareMethodFunc(typeName, objectPtr, isStatic, methodName, argTypes, argTypesSize, handle);
 }
 
-bool CoreClrHost::getProperty(int64_t objectPtr, const char* propertyName, int64_t* value) {
+bool CoreClrHost::callPreparedMethod(int32_t handle, int64_t objectPtr, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize) {
+	if (_coreClr == NULL && _hostHandle == NULL)
+		return false;
+
+	if (_useUnmanagedEntryPoints)
+		return _callPreparedMethodUnmanaged(handle, objectPtr, args, argsData, argsSize, results, resultsCapacity, resultsSize) != 0;
+
+	return _callPreparedMethodFunc(handle, objectPtr, args, argsData, argsSize, results, resultsCapacity, resultsSize);
+}
+
+bool CoreClrHost::getScalarSignature(int32_t handle, int32_t* kinds, int32_t capacity, int32_t* size) {
 	if (_coreClr == NULL && _hostHandle == NULL)
 	{
 		Rf_error("CoreCLR isn't started.");
 		return true;
 	}
 
-	return _getFunc(objectPtr, propertyName, value);
+	return _getScalarSignatureFunc(handle, kinds, capacity, size);
 }
 
-bool CoreClrHost::setProperty(int64_t objectPtr, const char* propertyName, int64_t value) {
+bool CoreClrHost::callPreparedScalar(int32_t handle, int64_t objectPtr, int64_t* args, int32_t argsSize, void* result) {
 	if (_coreClr == NULL && _hostHandle == NULL)
 	{
 		Rf_error("CoreCLR isn't started.");
 		return true;
 	}
 
-	return _setFunc(objectPtr, propertyName, value);
+	if (_useUnmanagedEntryPoints)
+		return _callPreparedScalarUnmanaged(handle, objectPtr, args, argsSize, result) != 0;
+
+	return _callPreparedScalarFunc(handle, objectPtr, args, argsSize, result);
+}
+
+bool CoreClrHost::callStaticMethodBatch(const char* typeName, const char* methodName, int32_t count, int32_t simplify, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* result) {
+	if (_coreClr == NULL && _hostHandle == NULL)
+		return false;
+
+	return _callStaticMethodBatchFunc(typeName, methodName, count, simplify, args, argsData, argsSize, result);
+}
+
+bool CoreClrHost::callMethodBatch(int64_t objectsPtr, const char* methodName, int32_t count, int32_t simplify, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* result) {
+	if (_coreClr == NULL && _hostHandle == NULL)
+		return false;
+
+	return _callMethodBatchFunc(objectsPtr, methodName, count, simplify, args, argsData, argsSize, result);
+}
+
+bool CoreClrHost::callStaticMethodAsync(const char* typeName, const char* methodName, int64_t* args, int64_t* argsData, int32_t argsSize, int32_t* handle) {
+	if (_coreClr == NULL && _hostHandle == NULL)
+		return false;
+
+	return _callStaticMethodAsyncFunc(typeName, methodName, args, argsData, argsSize, handle);
+}
+
+bool CoreClrHost::callMethodAsync(int64_t objectPtr, const char* methodName, int64_t* args, int64_t* argsData, int32_t argsSize, int32_t* handle) {
+	if (_coreClr == NULL && _hostHandle == NULL)
+		return false;
+
+	return _callMethodAsyncFunc(objectPtr, methodName, args, argsData, argsSize, handle);
+}
+
+bool CoreClrHost::waitCall(int32_t handle, int32_t timeout, int32_t* completed) {
+	if (_coreClr == NULL && _hostHandle == NULL)
+	{
+		Rf_error("CoreCLR isn't started.");
+		return true;
+	}
+
+	return _waitCallFunc(handle, timeout, completed);
+}
+
+bool CoreClrHost::awaitCall(int32_t handle, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize) {
+	if (_coreClr == NULL && _hostHandle == NULL)
+		return false;
+
+	return _awaitCallFunc(handle, results, resultsCapacity, resultsSize);
+}
+
+bool CoreClrHost::releaseCall(int32_t handle) {
+	// Called by a future finalizer, which may run once the runtime is shut down
+	if (_hostHandle == NULL)
+		return false;
+
+	return _releaseCallFunc(handle);
 }
 
 /*static*/ void CoreClrHost::build_tpa_list(const char* directory, std::string& tpaList)
@@ -397,17 +615,48 @@ bool CoreClrHost::setProperty(int64_t objectPtr, const char* propertyName, int64
 }
 
 void CoreClrHost::createManagedDelegate(const char* entryPointMethodName, void** delegate)
+{
+	int hr = tryCreateManagedDelegate("Sharper.ClrProxy", entryPointMethodName, delegate);
+	if (hr < 0)
+		Rf_error("coreclr_create_delegate for method %s failed - status: %d\n", entryPointMethodName, hr);
+}
+
+int CoreClrHost::tryCreateManagedDelegate(const char* entryPointTypeName, const char* entryPointMethodName, void** delegate)
 {
 	int hr = _createManagedDelegate(
 		_hostHandle,
 		_domainId,
 		"Sharper",
-		"Sharper.ClrProxy",
+		entryPointTypeName,
 		entryPointMethodName,
 		delegate);
 
-	if (hr < 0)
-		Rf_error("coreclr_create_delegate for method %s failed - status: %d\n", entryPointMethodName, hr);
+	return hr;
+}
+
+void CoreClrHost::bindUnmanagedEntryPoints()
+{
+	// On a runtime which supports UnmanagedCallersOnly (.Net 5+), coreclr_create_delegate gives directly 
+	// the method entry point. On an older runtime it gives a delegate with a blittable signature, still cheaper.
+	// If the managed side doesn't expose them, the marshalled entry points are kept.
+	const char* typeName = "Sharper.UnmanagedEntryPoints";
+	releaseObjectsUnmanaged = NULL;
+	_useUnmanagedEntryPoints =
+		tryCreateManagedDelegate(typeName, "CallStaticMethod", (void**)&_callStaticMethodUnmanaged) >= 0 &&
+		tryCreateManagedDelegate(typeName, "GetStaticProperty", (void**)&_getStaticPropertyUnmanaged) >= 0 &&
+		tryCreateManagedDelegate(typeName, "SetStaticProperty", (void**)&_setStaticPropertyUnmanaged) >= 0 &&
+		tryCreateManagedDelegate(typeName, "CreateObject", (void**)&_createObjectUnmanaged) >= 0 &&
+		tryCreateManagedDelegate(typeName, "CallMethod", (void**)&_callMethodUnmanaged) >= 0 &&
+		tryCreateManagedDelegate(typeName, "GetProperty", (void**)&_getPropertyUnmanaged) >= 0 &&
+		tryCreateManagedDelegate(typeName, "SetProperty", (void**)&_setPropertyUnmanaged) >= 0 &&
+		tryCreateManagedDelegate(typeName, "CallPreparedMethod", (void**)&_callPreparedMethodUnmanaged) >= 0 &&
+		tryCreateManagedDelegate(typeName, "CallPreparedScalar", (void**)&_callPreparedScalarUnmanaged) >= 0;
+
+	releaseObjectsUnmanaged_ptr release = NULL;
+	if (_useUnmanagedEntryPoints && tryCreateManagedDelegate(typeName, "ReleaseObjects", (void**)&release) >= 0)
+		releaseObjectsUnmanaged = release;
+
+	Rprintf(_useUnmanagedEntryPoints ? "CoreCLR entry points: unmanaged\n" : "CoreCLR entry points: marshalled\n");
 }
 
 struct version_t {
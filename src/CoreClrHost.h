@@ -13,6 +13,9 @@
 // For each hosting API, we define a function prototype and a function pointer
 // The prototype is useful for implicit linking against the dynamic coreclr
 // library and the pointer for explicit dynamic loading (dlopen, LoadLibrary)
+// The number of .Net objects collected by R which are released at once, if no call from R released them before
+#define RELEASE_OBJECTS_BATCH_SIZE 4096
+
 #define CORECLR_HOSTING_API(function, ...) \
 	extern "C" int CORECLR_CALLING_CONVENTION function(__VA_ARGS__); \
 	typedef int (CORECLR_CALLING_CONVENTION *function##_ptr)(__VA_ARGS__)
@@ -64,14 +67,39 @@ CORECLR_HOSTING_API(coreclr_execute_assembly,
 // Function pointer types for the managed call and callbacks
 typedef const char*(CORECLR_CALLING_CONVENTION *getLastError_ptr)();
 typedef bool (CORECLR_CALLING_CONVENTION *loadAssembly_ptr)(const char* pathOrAssemblyName);
-typedef bool (CORECLR_CALLING_CONVENTION *callStaticMethod_ptr)(const char* typeName, const char* methodName, int64_t* argsPtr, int32_t size, int64_t** results, int32_t* resultsSize);
+typedef bool (CORECLR_CALLING_CONVENTION *callStaticMethod_ptr)(const char* typeName, const char* methodName, int64_t* argsPtr, int64_t* argsData, int32_t argsSize, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize);
 typedef bool (CORECLR_CALLING_CONVENTION *getStaticProperty_ptr)(const char* typeName, const char* propertyName, int64_t* value);
 typedef bool (CORECLR_CALLING_CONVENTION *setStaticProperty_ptr)(const char* typeName, const char* propertyName, int64_t value);
-typedef bool (CORECLR_CALLING_CONVENTION *createObject_ptr)(const char* typeName, int64_t argPtr[], int32_t size, int64_t* value);
-typedef bool (CORECLR_CALLING_CONVENTION *releaseObject_ptr)(int64_t objPtr);
-typedef bool (CORECLR_CALLING_CONVENTION *callMethod_ptr)(int64_t objPtr, const char* methodName, int64_t* argsPtr, int32_t argsSize, int64_t** results, int32_t* resultsSize);
+typedef bool (CORECLR_CALLING_CONVENTION *createObject_ptr)(const char* typeName, int64_t* argsPtr, int64_t* argsData, int32_t argsSize, int64_t* value);
+typedef bool (CORECLR_CALLING_CONVENTION *releaseObjects_ptr)(int64_t* handles, int32_t count);
+typedef bool (CORECLR_CALLING_CONVENTION *callMethod_ptr)(int64_t objPtr, const char* methodName, int64_t* argsPtr, int64_t* argsData, int32_t argsSize, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize);
 typedef bool (CORECLR_CALLING_CONVENTION *getProperty_ptr)(int64_t objPtr, const char* methodName, int64_t* value);
 typedef bool (CORECLR_CALLING_CONVENTION *setProperty_ptr)(int64_t objPtr, const char* methodName, int64_t argPtr);
+typedef bool (CORECLR_CALLING_CONVENTION *prepareMethod_ptr)(const char* typeName, int64_t objPtr, int32_t isStatic, const char* methodName, const char** argTypes, int32_t argTypesSize, int32_t* handle);
+typedef bool (CORECLR_CALLING_CONVENTION *registerNativeCallbacks_ptr)(void* allocVector, void* callCompleted, void* allocArrowBatch);
+typedef bool (CORECLR_CALLING_CONVENTION *callStaticMethodBatch_ptr)(const char* typeName, const char* methodName, int32_t count, int32_t simplify, int64_t* argsPtr, int64_t* argsData, int32_t argsSize, int64_t* result);
+typedef bool (CORECLR_CALLING_CONVENTION *callMethodBatch_ptr)(int64_t objectsPtr, const char* methodName, int32_t count, int32_t simplify, int64_t* argsPtr, int64_t* argsData, int32_t argsSize, int64_t* result);
+typedef bool (CORECLR_CALLING_CONVENTION *callStaticMethodAsync_ptr)(const char* typeName, const char* methodName, int64_t* argsPtr, int64_t* argsData, int32_t argsSize, int32_t* handle);
+typedef bool (CORECLR_CALLING_CONVENTION *callMethodAsync_ptr)(int64_t objPtr, const char* methodName, int64_t* argsPtr, int64_t* argsData, int32_t argsSize, int32_t* handle);
+typedef bool (CORECLR_CALLING_CONVENTION *waitCall_ptr)(int32_t handle, int32_t timeout, int32_t* completed);
+typedef bool (CORECLR_CALLING_CONVENTION *awaitCall_ptr)(int32_t handle, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize);
+typedef bool (CORECLR_CALLING_CONVENTION *releaseCall_ptr)(int32_t handle);
+typedef bool (CORECLR_CALLING_CONVENTION *callPreparedMethod_ptr)(int32_t handle, int64_t objPtr, int64_t* argsPtr, int64_t* argsData, int32_t argsSize, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize);
+typedef bool (CORECLR_CALLING_CONVENTION *getScalarSignature_ptr)(int32_t handle, int32_t* kinds, int32_t capacity, int32_t* size);
+typedef bool (CORECLR_CALLING_CONVENTION *callPreparedScalar_ptr)(int32_t handle, int64_t objPtr, int64_t* args, int32_t argsSize, void* result);
+
+// Function pointer types for the blittable entry points, marked as UnmanagedCallersOnly on managed side.
+// The strings are given as UTF-8 data plus length and the results as pointers, so no marshalling stub is involved.
+typedef int32_t (CORECLR_CALLING_CONVENTION *callStaticMethodUnmanaged_ptr)(const char* typeName, int32_t typeNameLength, const char* methodName, int32_t methodNameLength, int64_t* argsPtr, int64_t* argsData, int32_t argsSize, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize);
+typedef int32_t (CORECLR_CALLING_CONVENTION *getStaticPropertyUnmanaged_ptr)(const char* typeName, int32_t typeNameLength, const char* propertyName, int32_t propertyNameLength, int64_t* value);
+typedef int32_t (CORECLR_CALLING_CONVENTION *setStaticPropertyUnmanaged_ptr)(const char* typeName, int32_t typeNameLength, const char* propertyName, int32_t propertyNameLength, int64_t value);
+typedef int32_t (CORECLR_CALLING_CONVENTION *createObjectUnmanaged_ptr)(const char* typeName, int32_t typeNameLength, int64_t* argsPtr, int64_t* argsData, int32_t argsSize, int64_t* value);
+typedef int32_t (CORECLR_CALLING_CONVENTION *releaseObjectsUnmanaged_ptr)(int64_t* handles, int32_t count);
+typedef int32_t (CORECLR_CALLING_CONVENTION *callMethodUnmanaged_ptr)(int64_t objPtr, const char* methodName, int32_t methodNameLength, int64_t* argsPtr, int64_t* argsData, int32_t argsSize, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize);
+typedef int32_t (CORECLR_CALLING_CONVENTION *getPropertyUnmanaged_ptr)(int64_t objPtr, const char* propertyName, int32_t propertyNameLength, int64_t* value);
+typedef int32_t (CORECLR_CALLING_CONVENTION *setPropertyUnmanaged_ptr)(int64_t objPtr, const char* propertyName, int32_t propertyNameLength, int64_t argPtr);
+typedef int32_t (CORECLR_CALLING_CONVENTION *callPreparedMethodUnmanaged_ptr)(int32_t handle, int64_t objPtr, int64_t* argsPtr, int64_t* argsData, int32_t argsSize, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize);
+typedef int32_t (CORECLR_CALLING_CONVENTION *callPreparedScalarUnmanaged_ptr)(int32_t handle, int64_t objPtr, int64_t* args, int32_t argsSize, void* result);
 
 class CoreClrHost : public ClrHost
 {
@@ -79,22 +107,40 @@ public:
 	CoreClrHost();
 	~CoreClrHost();
 
-	virtual void start(const char* app_base_dir, const char* package_bin_folder, const char* dotnet_install_path);
+	virtual void start(const char* app_base_dir, const char* package_bin_folder, const char* dotnet_install_path, const char* tpa_manifest_folder, const RuntimeConfig& config);
 	virtual void shutdown();
 
+	// Gets the properties given to coreclr_initialize, except the trusted platform assemblies.
+	const RuntimeConfig& getConfig() const { return _config; }
+
 protected:
 	virtual const char* getLastError();
 	virtual bool loadAssembly(const char* filePath);
-	virtual bool callStaticMethod(const char* typeName, const char* methodName, int64_t* args, int32_t argsSize, int64_t** results, int32_t* resultsSize);
+	virtual bool callStaticMethod(const char* typeName, const char* methodName, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize);
 	virtual bool getStaticProperty(const char* typeName, const char* propertyName, int64_t* value);
 	virtual bool setStaticProperty(const char* typeName, const char* propertyName, int64_t value);
 
-	virtual bool createObject(const char* typeName, int64_t* args, int32_t argsSize, int64_t* value);
+	virtual bool createObject(const char* typeName, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* value);
 	virtual void registerFinalizer(SEXP sexp);
-	virtual bool callMethod(int64_t objectPtr, const char* methodName, int64_t* args, int32_t argsSize, int64_t** results, int32_t* resultsSize);
+	virtual void releaseDeferredObjects();
+	virtual bool callMethod(int64_t objectPtr, const char* methodName, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize);
 	virtual bool getProperty(int64_t objectPtr, const char* propertyName, int64_t* value);
 	virtual bool setProperty(int64_t objectPtr, const char* propertyName, int64_t value);
 
+	virtual bool prepareMethod(const char* typeName, int64_t objectPtr, int32_t isStatic, const char* methodName, const char** argTypes, int32_t argTypesSize, int32_t* handle);
+	virtual bool callPreparedMethod(int32_t handle, int64_t objectPtr, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize);
+	virtual bool getScalarSignature(int32_t handle, int32_t* kinds, int32_t capacity, int32_t* size);
+	virtual bool callPreparedScalar(int32_t handle, int64_t objectPtr, int64_t* args, int32_t argsSize, void* result);
+
+	virtual bool callStaticMethodBatch(const char* typeName, const char* methodName, int32_t count, int32_t simplify, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* result);
+	virtual bool callMethodBatch(int64_t objectsPtr, const char* methodName, int32_t count, int32_t simplify, int64_t* args, int64_t* argsData, int32_t argsSize, int64_t* result);
+
+	virtual bool callStaticMethodAsync(const char* typeName, const char* methodName, int64_t* args, int64_t* argsData, int32_t argsSize, int32_t* handle);
+	virtual bool callMethodAsync(int64_t objectPtr, const char* methodName, int64_t* args, int64_t* argsData, int32_t argsSize, int32_t* handle);
+	virtual bool waitCall(int32_t handle, int32_t timeout, int32_t* completed);
+	virtual bool awaitCall(int32_t handle, int64_t* results, int32_t resultsCapacity, int32_t* resultsSize);
+	virtual bool releaseCall(int32_t handle);
+
 private:
 #if WINDOWS
 	HMODULE _coreClr;
@@ -102,10 +148,12 @@ private:
 	void* _coreClr;
 #endif
 	void* _hostHandle;
+	RuntimeConfig _config;
 
 	coreclr_initialize_ptr _initializeCoreClr;
 	coreclr_create_delegate_ptr _createManagedDelegate;
 	coreclr_shutdown_ptr _shutdownCoreClr;
+	registerNativeCallbacks_ptr _registerNativeCallbacksFunc;
 
 	getLastError_ptr _getLastErrorFunc;
 	loadAssembly_ptr _loadAssemblyFunc;
@@ -113,12 +161,43 @@ private:
 	getStaticProperty_ptr _getStaticPropertyFunc;
 	setStaticProperty_ptr _setStaticPropertyFunc;
 	createObject_ptr _createObjectFunc;
-	static releaseObject_ptr releaseObjectFunc;
+	static releaseObjects_ptr releaseObjectsFunc;
 	callMethod_ptr _callFunc;
 	getProperty_ptr _getFunc;
 	setProperty_ptr _setFunc;
+	prepareMethod_ptr _prepareMethodFunc;
+	callPreparedMethod_ptr _callPreparedMethodFunc;
+	getScalarSignature_ptr _getScalarSignatureFunc;
+	callPreparedScalar_ptr _callPreparedScalarFunc;
+	callStaticMethodBatch_ptr _callStaticMethodBatchFunc;
+	callMethodBatch_ptr _callMethodBatchFunc;
+	callStaticMethodAsync_ptr _callStaticMethodAsyncFunc;
+	callMethodAsync_ptr _callMethodAsyncFunc;
+	waitCall_ptr _waitCallFunc;
+	awaitCall_ptr _awaitCallFunc;
+	releaseCall_ptr _releaseCallFunc;
+
+	// Blittable entry points, used instead of the marshalled ones when the managed side exposes them
+	bool _useUnmanagedEntryPoints;
+	callStaticMethodUnmanaged_ptr _callStaticMethodUnmanaged;
+	getStaticPropertyUnmanaged_ptr _getStaticPropertyUnmanaged;
+	setStaticPropertyUnmanaged_ptr _setStaticPropertyUnmanaged;
+	createObjectUnmanaged_ptr _createObjectUnmanaged;
+	static releaseObjectsUnmanaged_ptr releaseObjectsUnmanaged;
+	callMethodUnmanaged_ptr _callMethodUnmanaged;
+	getPropertyUnmanaged_ptr _getPropertyUnmanaged;
+	setPropertyUnmanaged_ptr _setPropertyUnmanaged;
+	callPreparedMethodUnmanaged_ptr _callPreparedMethodUnmanaged;
+	callPreparedScalarUnmanaged_ptr _callPreparedScalarUnmanaged;
 
 	void createManagedDelegate(const char* entryPointMethodName, void** delegate);
+	int tryCreateManagedDelegate(const char* entryPointTypeName, const char* entryPointMethodName, void** delegate);
+	void bindUnmanagedEntryPoints();
+
+	// The handles of the .Net objects collected by R, released by batch instead of one .Net call per finalizer
+	static std::vector<int64_t> releasedObjects;
+	static void releaseObject(SEXP sexp);
+	static void flushReleasedObjects();
 	
 	static bool get_core_clr_with_tpa_list(const char* app_base_dir, const char* package_bin_folder, const char* dotnet_install_path, std::string& core_clr, std::string& tpa_list);
 	static void build_tpa_list(const char* directory, std::string& tpaList);
@@ -1,8 +1,25 @@
 #include "RClrProxy.h"
 
-void rStartClr(char** app_base_dir, char** package_bin_path, char** dotnet_core_path)
+void rStartClr(char** app_base_dir, char** package_bin_path, char** dotnet_core_path, char** tpa_manifest_folder, 
+	char** runtime_config_file, char** config_keys, char** config_values, int* config_size)
 {
-	mainHost.start(first_or_default(app_base_dir), first_or_default(package_bin_path), first_or_default(dotnet_core_path));
+	RuntimeConfig config;
+
+	// The runtimeconfig.json properties first, then the ones given from R override them
+	const char* runtime_config_path = first_or_default(runtime_config_file);
+	if (runtime_config_path != NULL && runtime_config_path[0] != '\0')
+	{
+		std::string message;
+		if (!config.loadJson(runtime_config_path, message))
+			Rf_error("Failed to read the runtime config %s: %s\n", runtime_config_path, message.c_str());
+		Rprintf("Runtime config: %s\n", runtime_config_path);
+	}
+
+	int size = config_size == NULL ? 0 : config_size[0];
+	for (int i = 0; i < size; i++)
+		config.set(config_keys[i], config_values[i]);
+
+	mainHost.start(first_or_default(app_base_dir), first_or_default(package_bin_path), first_or_default(dotnet_core_path), first_or_default(tpa_manifest_folder), config);
 }
 
 void rShutdownClr()
@@ -51,3 +68,94 @@ SEXP rSetProperty(SEXP p)
 	mainHost.rSetProperty(p);
 	return R_NilValue;
 }
+
+SEXP rPrepareMethod(SEXP p)
+{
+	return mainHost.rPrepareMethod(p);
+}
+
+SEXP rCallPreparedMethod(SEXP p)
+{
+	return mainHost.rCallPreparedMethod(p);
+}
+
+SEXP rCallStaticMethodBatch(SEXP p)
+{
+	return mainHost.rCallStaticMethodBatch(p);
+}
+
+SEXP rCallMethodBatch(SEXP p)
+{
+	return mainHost.rCallMethodBatch(p);
+}
+
+SEXP rCallStaticMethodAsync(SEXP p)
+{
+	return mainHost.rCallStaticMethodAsync(p);
+}
+
+SEXP rCallMethodAsync(SEXP p)
+{
+	return mainHost.rCallMethodAsync(p);
+}
+
+SEXP rWaitCall(SEXP p)
+{
+	return mainHost.rWaitCall(p);
+}
+
+SEXP rAwaitCall(SEXP p)
+{
+	return mainHost.rAwaitCall(p);
+}
+
+SEXP rThenCall(SEXP p)
+{
+	return mainHost.rThenCall(p);
+}
+
+SEXP rRunCompletedCalls(SEXP p)
+{
+	mainHost.runCompletedCalls();
+	return R_NilValue;
+}
+
+SEXP rEnableStats(SEXP p)
+{
+	SEXP e = CAR(CDR(p)); // Skip the first parameter because of function name
+	if (TYPEOF(e) != LGLSXP || LENGTH(e) != 1 || LOGICAL(e)[0] == NA_LOGICAL)
+		error("[ERROR] rEnableStats: need a LGLSXP of length 1 which isn't NA\n");
+
+	bool wasEnabled = CallStats::enabled;
+	CallStats::enabled = LOGICAL(e)[0] != 0;
+	return Rf_ScalarLogical(wasEnabled);
+}
+
+SEXP rGetStats(SEXP p)
+{
+	return CallStats::toSexp();
+}
+
+SEXP rResetStats(SEXP p)
+{
+	CallStats::reset();
+	return R_NilValue;
+}
+
+SEXP rGetClrConfig(SEXP p)
+{
+	const RuntimeConfig& config = mainHost.getConfig();
+	R_xlen_t size = (R_xlen_t)config.size();
+
+	SEXP values = PROTECT(Rf_allocVector(STRSXP, size));
+	SEXP names = PROTECT(Rf_allocVector(STRSXP, size));
+	for (R_xlen_t i = 0; i < size; i++)
+	{
+		SET_STRING_ELT(values, i, Rf_mkChar(config.values()[i].c_str()));
+		SET_STRING_ELT(names, i, Rf_mkChar(config.keys()[i].c_str()));
+	}
+	Rf_setAttrib(values, R_NamesSymbol, names);
+
+	UNPROTECT(2);
+	return values;
+}
\ No newline at end of file
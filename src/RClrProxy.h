@@ -10,7 +10,8 @@ static CoreClrHost mainHost = CoreClrHost();
 extern "C" {
 #endif
 	// ClrEnvironment methods
-	void rStartClr(char** app_base_dir, char** package_bin_path, char** dotnet_core_path);
+	void rStartClr(char** app_base_dir, char** package_bin_path, char** dotnet_core_path, char** tpa_manifest_folder, 
+		char** runtime_config_file, char** config_keys, char** config_values, int* config_size);
 	void rShutdownClr();
 
 	void rLoadAssembly(char** fileName);
@@ -24,6 +25,28 @@ extern "C" {
 	SEXP rGetProperty(SEXP p);
 	SEXP rSetProperty(SEXP p);
 
+	SEXP rPrepareMethod(SEXP p);
+	SEXP rCallPreparedMethod(SEXP p);
+
+	SEXP rCallStaticMethodBatch(SEXP p);
+	SEXP rCallMethodBatch(SEXP p);
+
+	// Async calls
+	SEXP rCallStaticMethodAsync(SEXP p);
+	SEXP rCallMethodAsync(SEXP p);
+	SEXP rWaitCall(SEXP p);
+	SEXP rAwaitCall(SEXP p);
+	SEXP rThenCall(SEXP p);
+	SEXP rRunCompletedCalls(SEXP p);
+
+	// Call stats
+	SEXP rEnableStats(SEXP p);
+	SEXP rGetStats(SEXP p);
+	SEXP rResetStats(SEXP p);
+
+	// Runtime config
+	SEXP rGetClrConfig(SEXP p);
+
 #ifdef __cplusplus
 } // end of extern "C" block
 #endif
@@ -0,0 +1,284 @@
+#include "RuntimeConfig.h"
+
+#include <cctype>
+#include <fstream>
+#include <sstream>
+
+// Minimal JSON reader, enough for a runtimeconfig.json file.
+// The scalar values are kept as their text, so numbers and booleans are given as is to the CoreCLR.
+class JsonReader
+{
+public:
+	JsonReader(const std::string& text) : _text(text), _pos(0) { }
+
+	std::string error;
+
+	// Depth given to read a value without collecting anything
+	static const size_t Skip = (size_t)-1;
+
+	// Reads the value at the current position and collects the scalars of the object found at the given path.
+	bool readValue(const std::vector<std::string>& path, size_t depth, RuntimeConfig& config)
+	{
+		skipSpaces();
+		if (_pos >= _text.size()) return fail("Unexpected end of file");
+
+		char c = _text[_pos];
+		if (c == '{') return readObject(path, depth, config);
+		if (c == '[') return readArray(path, config);
+
+		std::string value;
+		return readScalar(value);
+	}
+
+	bool readEnd()
+	{
+		skipSpaces();
+		return _pos == _text.size() || fail("Unexpected content after the root value");
+	}
+
+private:
+	const std::string& _text;
+	size_t _pos;
+
+	bool readObject(const std::vector<std::string>& path, size_t depth, RuntimeConfig& config)
+	{
+		_pos++; // {
+		skipSpaces();
+		if (peek('}')) { _pos++; return true; }
+
+		while (true)
+		{
+			skipSpaces();
+			std::string key;
+			if (!readString(key)) return false;
+			skipSpaces();
+			if (!peek(':')) return fail("Expected ':'");
+			_pos++;
+			skipSpaces();
+
+			if (depth == Skip)
+			{
+				if (!readValue(path, Skip, config)) return false;
+			}
+			else if (depth == path.size())
+			{
+				// Inside the searched object, its scalar values are the properties
+				if (peek('{') || peek('['))
+				{
+					if (!readValue(path, Skip, config)) return false;
+				}
+				else
+				{
+					std::string value;
+					if (!readScalar(value)) return false;
+					config.set(key, value);
+				}
+			}
+			else if (depth < path.size() && key == path[depth])
+			{
+				if (!readValue(path, depth + 1, config)) return false;
+			}
+			else
+			{
+				// Not on the searched path, the value is read and ignored
+				if (!readValue(path, Skip, config)) return false;
+			}
+
+			skipSpaces();
+			if (peek(',')) { _pos++; continue; }
+			if (peek('}')) { _pos++; return true; }
+			return fail("Expected ',' or '}'");
+		}
+	}
+
+	bool readArray(const std::vector<std::string>& path, RuntimeConfig& config)
+	{
+		_pos++; // [
+		skipSpaces();
+		if (peek(']')) { _pos++; return true; }
+
+		// The properties are never in an array
+		while (true)
+		{
+			if (!readValue(path, Skip, config)) return false;
+			skipSpaces();
+			if (peek(',')) { _pos++; continue; }
+			if (peek(']')) { _pos++; return true; }
+			return fail("Expected ',' or ']'");
+		}
+	}
+
+	bool readScalar(std::string& value)
+	{
+		if (peek('"')) return readString(value);
+
+		size_t start = _pos;
+		while (_pos < _text.size() && (isalnum((unsigned char)_text[_pos]) || _text[_pos] == '-' || _text[_pos] == '+' || _text[_pos] == '.'))
+			_pos++;
+		if (start == _pos) return fail("Unexpected character");
+
+		value = _text.substr(start, _pos - start);
+		if (value == "null") value.clear();
+		return true;
+	}
+
+	bool readString(std::string& value)
+	{
+		if (!peek('"')) return fail("Expected a string");
+		_pos++;
+
+		while (_pos < _text.size())
+		{
+			char c = _text[_pos++];
+			if (c == '"') return true;
+			if (c != '\\')
+			{
+				value.push_back(c);
+				continue;
+			}
+
+			if (_pos >= _text.size()) break;
+			c = _text[_pos++];
+			switch (c)
+			{
+			case 'b': value.push_back('\b'); break;
+			case 'f': value.push_back('\f'); break;
+			case 'n': value.push_back('\n'); break;
+			case 'r': value.push_back('\r'); break;
+			case 't': value.push_back('\t'); break;
+			case 'u':
+			{
+				unsigned int code;
+				if (!readHex4(code)) return fail("Invalid unicode escape");
+
+				// A character beyond the basic plane is escaped as a surrogate pair, encoded as one UTF-8 sequence
+				if (code >= 0xD800 && code <= 0xDBFF)
+				{
+					unsigned int low;
+					if (!peek('\\') || _pos + 1 >= _text.size() || _text[_pos + 1] != 'u') return fail("Invalid unicode surrogate pair");
+					_pos += 2;
+					if (!readHex4(low)) return fail("Invalid unicode escape");
+					if (low < 0xDC00 || low > 0xDFFF) return fail("Invalid unicode surrogate pair");
+					code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+				}
+				else if (code >= 0xDC00 && code <= 0xDFFF)
+					return fail("Invalid unicode surrogate pair");
+
+				appendUtf8(value, code);
+				break;
+			}
+			default: value.push_back(c); break;
+			}
+		}
+
+		return fail("Unterminated string");
+	}
+
+	bool readHex4(unsigned int& code)
+	{
+		if (_pos + 4 > _text.size()) return false;
+
+		code = 0;
+		for (size_t i = 0; i < 4; i++)
+		{
+			char c = _text[_pos + i];
+			if (!isxdigit((unsigned char)c)) return false;
+			code = code * 16 + (isdigit((unsigned char)c) ? c - '0' : (tolower((unsigned char)c) - 'a' + 10));
+		}
+
+		_pos += 4;
+		return true;
+	}
+
+	static void appendUtf8(std::string& value, unsigned int code)
+	{
+		if (code < 0x80)
+			value.push_back((char)code);
+		else if (code < 0x800)
+		{
+			value.push_back((char)(0xC0 | (code >> 6)));
+			value.push_back((char)(0x80 | (code & 0x3F)));
+		}
+		else if (code < 0x10000)
+		{
+			value.push_back((char)(0xE0 | (code >> 12)));
+			value.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+			value.push_back((char)(0x80 | (code & 0x3F)));
+		}
+		else
+		{
+			value.push_back((char)(0xF0 | (code >> 18)));
+			value.push_back((char)(0x80 | ((code >> 12) & 0x3F)));
+			value.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+			value.push_back((char)(0x80 | (code & 0x3F)));
+		}
+	}
+
+	void skipSpaces()
+	{
+		while (_pos < _text.size() && isspace((unsigned char)_text[_pos]))
+			_pos++;
+	}
+
+	bool peek(char c) const { return _pos < _text.size() && _text[_pos] == c; }
+
+	bool fail(const char* message)
+	{
+		std::ostringstream stream;
+		stream << message << " at offset " << _pos;
+		error = stream.str();
+		return false;
+	}
+};
+
+void RuntimeConfig::set(const std::string& key, const std::string& value)
+{
+	for (size_t i = 0; i < _keys.size(); i++)
+	{
+		if (_keys[i] != key) continue;
+
+		_values[i] = value;
+		return;
+	}
+
+	_keys.push_back(key);
+	_values.push_back(value);
+}
+
+bool RuntimeConfig::contains(const std::string& key) const
+{
+	for (size_t i = 0; i < _keys.size(); i++)
+		if (_keys[i] == key) return true;
+	return false;
+}
+
+bool RuntimeConfig::loadJson(const char* path, std::string& error)
+{
+	std::ifstream file(path, std::ios::in | std::ios::binary);
+	if (!file)
+	{
+		error = "Can't read the file";
+		return false;
+	}
+
+	std::stringstream buffer;
+	buffer << file.rdbuf();
+	std::string text = buffer.str();
+
+	// Skips the UTF-8 BOM written by some editors
+	size_t start = text.compare(0, 3, "\xEF\xBB\xBF") == 0 ? 3 : 0;
+	text.erase(0, start);
+
+	std::vector<std::string> path_to_properties;
+	path_to_properties.push_back("runtimeOptions");
+	path_to_properties.push_back("configProperties");
+
+	JsonReader reader(text);
+	if (!reader.readValue(path_to_properties, 0, *this) || !reader.readEnd())
+	{
+		error = reader.error;
+		return false;
+	}
+
+	return true;
+}
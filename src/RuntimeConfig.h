@@ -0,0 +1,28 @@
+#ifndef __RUNTIME_CONFIG_H__
+#define __RUNTIME_CONFIG_H__
+
+#include <string>
+#include <vector>
+
+// Properties given to coreclr_initialize, as GC mode, tiered compilation or probing paths.
+// They come from the configProperties of a runtimeconfig.json file, then from R which overrides them.
+class RuntimeConfig
+{
+public:
+	// Adds a property or replaces its value if it's already defined.
+	void set(const std::string& key, const std::string& value);
+	bool contains(const std::string& key) const;
+
+	// Reads the runtimeOptions.configProperties section of a runtimeconfig.json file.
+	bool loadJson(const char* path, std::string& error);
+
+	size_t size() const { return _keys.size(); }
+	const std::vector<std::string>& keys() const { return _keys; }
+	const std::vector<std::string>& values() const { return _values; }
+
+private:
+	std::vector<std::string> _keys;
+	std::vector<std::string> _values;
+};
+
+#endif // !__RUNTIME_CONFIG_H__
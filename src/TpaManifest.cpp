@@ -0,0 +1,129 @@
+#include "TpaManifest.h"
+#include "ClrHost.h"
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+#if !WINDOWS
+#include <unistd.h>
+#endif
+
+#define TPA_MANIFEST_HEADER "sharper-tpa-manifest 1"
+
+TpaManifest::TpaManifest(const char* folder, const std::vector<std::string>& directories)
+{
+	std::string key;
+	for (size_t i = 0; i < directories.size(); i++)
+	{
+		_directories.push_back(std::make_pair(directories[i], last_write_time(directories[i].c_str())));
+		key.append(directories[i]).append(PATH_DELIMITER);
+	}
+
+	if (folder == NULL || folder[0] == '\0' || !is_directory(folder))
+		return;
+
+	// One manifest per set of directories, so different apps can share the folder
+	std::ostringstream fileName;
+	fileName << "tpa-" << std::hex << std::hash<std::string>()(key) << ".manifest";
+	std::string folderPath(folder);
+	path_combine(folderPath, fileName.str().c_str(), _filePath);
+}
+
+bool TpaManifest::load(std::string& core_clr, std::string& tpa_list) const
+{
+	if (!isEnabled()) return false;
+
+	std::ifstream file(_filePath.c_str());
+	if (!file) return false;
+
+	std::string line;
+	if (!std::getline(file, line) || line != TPA_MANIFEST_HEADER)
+		return false;
+
+	// Each directory has to be found with the same last write time
+	for (size_t i = 0; i < _directories.size(); i++)
+	{
+		std::ostringstream expected;
+		expected << "directory\t" << _directories[i].second << "\t" << _directories[i].first;
+		if (!std::getline(file, line) || line != expected.str())
+			return false;
+	}
+
+	std::string coreClrLine, tpaLine;
+	if (!std::getline(file, coreClrLine) || coreClrLine.compare(0, 8, "coreclr\t") != 0)
+		return false;
+	if (!std::getline(file, tpaLine) || tpaLine.compare(0, 4, "tpa\t") != 0)
+		return false;
+
+	std::string coreClrPath = coreClrLine.substr(8);
+	if (!file_exists(coreClrPath.c_str()))
+		return false;
+
+	core_clr.assign(coreClrPath);
+	tpa_list.assign(tpaLine.substr(4));
+	return true;
+}
+
+bool TpaManifest::save(const std::string& core_clr, const std::string& tpa_list) const
+{
+	if (!isEnabled()) return false;
+
+	// Written aside then renamed, so a concurrent start never reads a partial manifest
+	std::ostringstream tmpPath;
+#if WINDOWS
+	tmpPath << _filePath << "." << GetCurrentProcessId() << ".tmp";
+#else
+	tmpPath << _filePath << "." << getpid() << ".tmp";
+#endif
+
+	{
+		std::ofstream file(tmpPath.str().c_str(), std::ios::out | std::ios::trunc);
+		if (!file) return false;
+
+		file << TPA_MANIFEST_HEADER << "\n";
+		for (size_t i = 0; i < _directories.size(); i++)
+			file << "directory\t" << _directories[i].second << "\t" << _directories[i].first << "\n";
+		file << "coreclr\t" << core_clr << "\n";
+		file << "tpa\t" << tpa_list << "\n";
+
+		file.flush();
+		if (!file)
+		{
+			file.close();
+			std::remove(tmpPath.str().c_str());
+			return false;
+		}
+	}
+
+#if WINDOWS
+	bool renamed = MoveFileExA(tmpPath.str().c_str(), _filePath.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	bool renamed = std::rename(tmpPath.str().c_str(), _filePath.c_str()) == 0;
+#endif
+	if (!renamed)
+		std::remove(tmpPath.str().c_str());
+	return renamed;
+}
+
+/*static*/ int64_t TpaManifest::last_write_time(const char* path)
+{
+	if (path == NULL) return -1;
+
+#if WINDOWS
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesExA(path, GetFileExInfoStandard, &data))
+		return -1;
+	return ((int64_t)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+#else
+	struct stat info;
+	if (stat(path, &info) != 0)
+		return -1;
+#if OSX
+	return (int64_t)info.st_mtimespec.tv_sec * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+	return (int64_t)info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+#endif
+}
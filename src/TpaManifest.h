@@ -0,0 +1,32 @@
+#ifndef __TPA_MANIFEST_H__
+#define __TPA_MANIFEST_H__
+
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Caches the coreclr path and the trusted platform assemblies list resolved when the CoreCLR starts,
+// so the next starts don't scan the directories again.
+// The manifest is keyed by the scanned directories and their last write time. Adding, removing or renaming
+// an assembly changes the time of its directory, then the manifest is rebuilt.
+class TpaManifest
+{
+public:
+	// folder: where the manifests are stored, the cache is disabled if NULL or empty.
+	TpaManifest(const char* folder, const std::vector<std::string>& directories);
+
+	bool isEnabled() const { return !_filePath.empty(); }
+
+	bool load(std::string& core_clr, std::string& tpa_list) const;
+	bool save(const std::string& core_clr, const std::string& tpa_list) const;
+
+	// Gets the last write time of a file or a directory with the best resolution available, -1 if it doesn't exist.
+	static int64_t last_write_time(const char* path);
+
+private:
+	std::string _filePath;
+	std::vector<std::pair<std::string, int64_t> > _directories;
+};
+
+#endif // !__TPA_MANIFEST_H__
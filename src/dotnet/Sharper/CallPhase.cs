@@ -0,0 +1,17 @@
+﻿namespace Sharper
+{
+    /// <summary>
+    /// The phases of a call from R measured by <see cref="CallStatistics"/>.
+    /// </summary>
+    public enum CallPhase
+    {
+        /// <summary>Type, member and overload resolution.</summary>
+        Resolution,
+        /// <summary>Conversion of the R arguments to .Net.</summary>
+        Conversion,
+        /// <summary>Invocation of the .Net member.</summary>
+        Invocation,
+        /// <summary>Conversion of the results back to R.</summary>
+        Wrapping
+    }
+}
@@ -0,0 +1,101 @@
+﻿using System;
+using System.Reflection;
+using System.Threading.Tasks;
+
+namespace Sharper.CallSites
+{
+    /// <summary>
+    /// A method invoked on the thread pool for R, which doesn't wait for it.
+    /// The arguments are converted on the R thread before the call starts and the results are converted back 
+    /// on the R thread once awaited, because the R API isn't thread safe.
+    /// A method returning a Task or a ValueTask completes with its task, which is awaited without blocking a thread,
+    /// so many I/O bound calls can overlap.
+    /// </summary>
+    public class AsyncCall
+    {
+        private readonly Task<object[]> _task;
+
+        /// <param name="handle">The handle which R knows the call by, given back to the host when the call completes.</param>
+        /// <param name="method">The method to invoke.</param>
+        /// <param name="instance">The instance, null for a static method.</param>
+        /// <param name="args">The arguments, already converted. They can't view the R vectors memory.</param>
+        public AsyncCall(int handle, MethodInfo method, object instance, object[] args)
+        {
+            Handle = handle;
+            Method = method;
+
+            var isTask = method.ReturnType.IsTask(out var taskResultType);
+            ResultType = isTask ? taskResultType : method.ReturnType;
+
+            var invoker = MethodInvoker.Get(method);
+            _task = Task.Run(async () =>
+            {
+                var result = invoker.Invoke(instance, args);
+                if (isTask)
+                    result = await GetTaskResult(method.ReturnType, result);
+
+                if (!invoker.HasByRef)
+                    return new[] { result };
+
+                // The returned value then the out or ref arguments
+                var results = new object[1 + args.Length];
+                results[0] = result;
+                Array.Copy(args, 0, results, 1, args.Length);
+                return results;
+            });
+
+            _task.ContinueWith(t => NativeCallbacks.CallCompleted(Handle), TaskContinuationOptions.ExecuteSynchronously);
+        }
+
+        /// <summary>
+        /// Gets the handle of the call.
+        /// </summary>
+        public int Handle { get; }
+
+        /// <summary>
+        /// Gets the invoked method.
+        /// </summary>
+        public MethodInfo Method { get; }
+
+        /// <summary>
+        /// Gets the type of the result given back to R, the task result type for a method returning a task.
+        /// </summary>
+        public Type ResultType { get; }
+
+        /// <summary>
+        /// Waits for the call to complete, successfully or not.
+        /// </summary>
+        /// <param name="timeout">The time to wait in milliseconds, negative to wait until it completes.</param>
+        /// <returns>True if the call is completed.</returns>
+        public bool Wait(int timeout)
+        {
+            if (_task.IsCompleted) return true;
+
+            return ((IAsyncResult)_task).AsyncWaitHandle.WaitOne(timeout < 0 ? -1 : timeout);
+        }
+
+        /// <summary>
+        /// Gets the returned value followed by the out or ref arguments, waiting for the call to complete.
+        /// Throws the exception raised by the method if it failed.
+        /// </summary>
+        public object[] GetResults() => _task.GetAwaiter().GetResult();
+
+        private static async Task<object> GetTaskResult(Type taskType, object returned)
+        {
+            if (returned == null)
+                throw new InvalidOperationException($"The method returned a null {taskType}");
+
+            // A ValueTask is boxed, it's awaited through its Task
+            var task = taskType.IsValueType
+                ? (Task)taskType.GetMethod("AsTask", Type.EmptyTypes).Invoke(returned, null)
+                : (Task)returned;
+            await task.ConfigureAwait(false);
+
+            if (!taskType.IsGenericType) return null;
+
+            // The runtime type of an async method task is a derived one, the result is read from the declared type
+            var resultProperty = typeof(Task<>).MakeGenericType(taskType.GetGenericArguments()[0]).GetProperty(nameof(Task<object>.Result));
+            return resultProperty.GetValue(task);
+        }
+    }
+}
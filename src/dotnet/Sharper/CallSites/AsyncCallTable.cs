@@ -0,0 +1,30 @@
+﻿using System.Collections.Concurrent;
+using System.Threading;
+
+namespace Sharper.CallSites
+{
+    /// <summary>
+    /// Stores the calls in flight for R, by handle.
+    /// A call is removed once R has got its results or has released its future.
+    /// </summary>
+    public static class AsyncCallTable
+    {
+        private static readonly ConcurrentDictionary<int, AsyncCall> calls = new ConcurrentDictionary<int, AsyncCall>();
+        private static int lastHandle;
+
+        public static int Count => calls.Count;
+
+        /// <summary>
+        /// Gets a new handle, given to the call before it starts so it can notify its completion.
+        /// </summary>
+        public static int NewHandle() => Interlocked.Increment(ref lastHandle);
+
+        public static void Add(AsyncCall call) => calls[call.Handle] = call;
+
+        public static bool TryGet(int handle, out AsyncCall call) 
+            => calls.TryGetValue(handle, out call);
+
+        public static bool Remove(int handle) 
+            => calls.TryRemove(handle, out _);
+    }
+}
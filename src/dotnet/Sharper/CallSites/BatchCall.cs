@@ -0,0 +1,166 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Reflection;
+using Sharper.Converters;
+
+namespace Sharper.CallSites
+{
+    /// <summary>
+    /// Calls a method many times within a single transition from R.
+    /// The arguments are given by columns, each one holds a value per call or a single value recycled for all calls.
+    /// The overload is resolved once from the first call arguments, then each column is converted once
+    /// into an array of the parameter type, so the loop only reads the arrays and invokes the method.
+    /// </summary>
+    public class BatchCall
+    {
+        private readonly IDataConverter _dataConverter;
+        private readonly string _methodName;
+        private readonly BindingFlags _flags;
+        private readonly IConverter[] _columns;
+        private readonly IConverter[] _firsts;
+        private readonly int _count;
+        private readonly Dictionary<Type, Binding> _bindings = new Dictionary<Type, Binding>();
+
+        /// <param name="dataConverter">The data converter, to know which results can be converted back as a vector.</param>
+        /// <param name="methodName">The method name.</param>
+        /// <param name="flags">The binding flags to resolve the method.</param>
+        /// <param name="columns">The arguments converters, one column per parameter.</param>
+        /// <param name="firsts">The first call arguments converters, used to resolve the overload.</param>
+        /// <param name="count">The number of calls.</param>
+        public BatchCall(IDataConverter dataConverter, string methodName, BindingFlags flags, IConverter[] columns, IConverter[] firsts, int count)
+        {
+            if (columns.Length != firsts.Length)
+                throw new ArgumentException($"Expected the first call argument of each column, columns: {columns.Length}, first arguments: {firsts.Length}");
+            if (count < 0)
+                throw new ArgumentOutOfRangeException(nameof(count));
+
+            _dataConverter = dataConverter;
+            _methodName = methodName;
+            _flags = flags;
+            _columns = columns;
+            _firsts = firsts;
+            _count = count;
+        }
+
+        /// <summary>
+        /// Calls a static method for each set of arguments.
+        /// </summary>
+        /// <returns>The returned values, typed when the return type can be converted back as a vector, null for a void method.</returns>
+        public Array Call(Type type, bool simplify)
+        {
+            var binding = GetBinding(type);
+            var results = binding.ReturnType == typeof(void) ? null : CreateResults(binding.ReturnType, simplify);
+
+            var args = new object[_columns.Length];
+            for (var i = 0; i < _count; i++)
+            {
+                var result = binding.Invoke(null, args, i);
+                results?.SetValue(result, i);
+            }
+            CallStatistics.Mark(CallPhase.Invocation);
+
+            return results;
+        }
+
+        /// <summary>
+        /// Calls an instance method for each object with its set of arguments.
+        /// The objects may have different types, the method is then resolved once per type.
+        /// </summary>
+        /// <returns>The returned values, typed when all the calls share a return type which can be converted back as a vector.</returns>
+        public Array Call(object[] instances, bool simplify)
+        {
+            if (instances.Length != _count)
+                throw new ArgumentException($"Expected {_count} objects but {instances.Length} have been given");
+            if (_count == 0) return new object[0];
+
+            var bindings = new Binding[_count];
+            Type returnType = null;
+            var isVoid = true;
+            for (var i = 0; i < _count; i++)
+            {
+                if (instances[i] == null)
+                    throw new ArgumentNullException(nameof(instances), $"The object at index {i + 1} is null");
+
+                bindings[i] = GetBinding(instances[i].GetType());
+                isVoid &= bindings[i].ReturnType == typeof(void);
+                returnType = returnType == null || returnType == bindings[i].ReturnType ? bindings[i].ReturnType : typeof(object);
+            }
+
+            var results = isVoid ? null : CreateResults(returnType, simplify);
+
+            var args = new object[_columns.Length];
+            for (var i = 0; i < _count; i++)
+            {
+                var result = bindings[i].Invoke(instances[i], args, i);
+                results?.SetValue(result, i);
+            }
+            CallStatistics.Mark(CallPhase.Invocation);
+
+            return results;
+        }
+
+        private Array CreateResults(Type returnType, bool simplify)
+        {
+            // Only the types converted back as an R vector are simplified, the others stay a list
+            return simplify && _dataConverter.IsDefined(returnType.MakeArrayType())
+                ? Array.CreateInstance(returnType, _count)
+                : new object[_count];
+        }
+
+        private Binding GetBinding(Type type)
+        {
+            if (_bindings.TryGetValue(type, out var binding))
+                return binding;
+
+            if (!type.TryGetMethod(_methodName, _flags, _firsts, out var method))
+                throw new MissingMethodException($"Method not found for Type: {type}, Method: {_methodName}");
+            CallStatistics.Mark(CallPhase.Resolution);
+
+            binding = new Binding(method, _columns, _count);
+            CallStatistics.Mark(CallPhase.Conversion);
+            _bindings.Add(type, binding);
+            return binding;
+        }
+
+        private class Binding
+        {
+            private readonly Func<object, object[], object> _invoke;
+            private readonly Array[] _arguments;
+
+            public Binding(MethodInfo method, IConverter[] columns, int count)
+            {
+                _invoke = MethodInvoker.Get(method).Invoke;
+                ReturnType = method.ReturnType;
+
+                var parameters = method.GetParameters();
+                _arguments = new Array[parameters.Length];
+                for (var i = 0; i < parameters.Length; i++)
+                {
+                    var parameterType = parameters[i].ParameterType;
+                    if (parameterType.IsByRef || parameterType.IsSpan())
+                        throw new NotSupportedException($"Out, ref or span parameters aren't supported by a batch call, method: {method}");
+
+                    // Converts the whole column at once, the loop then only reads the array
+                    var array = (Array)columns[i].Convert(parameterType.Extract().MakeArrayType());
+                    if (array.Length != count && array.Length != 1)
+                        throw new ArgumentException($"The argument {i + 1} has {array.Length} values, expected {count} or 1");
+
+                    _arguments[i] = array;
+                }
+            }
+
+            public Type ReturnType { get; }
+
+            public object Invoke(object instance, object[] args, int index)
+            {
+                for (var i = 0; i < _arguments.Length; i++)
+                {
+                    var array = _arguments[i];
+                    args[i] = array.GetValue(array.Length == 1 ? 0 : index);
+                }
+
+                return _invoke(instance, args);
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+﻿using System;
+using System.Reflection;
+
+namespace Sharper.CallSites
+{
+    /// <summary>
+    /// Defines a .Net method resolved once, which can be invoked many times
+    /// without any type, name or overload resolution.
+    /// </summary>
+    public class CallSite
+    {
+        public CallSite(int handle, Type type, MethodInfo method)
+        {
+            Handle = handle;
+            Type = type;
+            Method = method;
+            Parameters = method.GetParameters();
+            ScalarInvoker.TryCreate(method, out var scalar);
+            Scalar = scalar;
+        }
+
+        /// <summary>
+        /// Gets the handle shared with R to identify this call site.
+        /// </summary>
+        public int Handle { get; }
+
+        /// <summary>
+        /// Gets the type on which the method has been resolved.
+        /// </summary>
+        public Type Type { get; }
+
+        /// <summary>
+        /// Gets the resolved method.
+        /// </summary>
+        public MethodInfo Method { get; }
+
+        /// <summary>
+        /// Gets the resolved method parameters.
+        /// </summary>
+        public ParameterInfo[] Parameters { get; }
+
+        /// <summary>
+        /// Gets the invoker from raw values if the method only takes and returns scalars, null otherwise.
+        /// </summary>
+        public ScalarInvoker Scalar { get; }
+
+        /// <summary>
+        /// Gets if the resolved method is static.
+        /// </summary>
+        public bool IsStatic => Method.IsStatic;
+
+        public override string ToString()
+            => $"#{Handle} {Type.FullName}.{Method}";
+    }
+}
@@ -0,0 +1,49 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Reflection;
+
+namespace Sharper.CallSites
+{
+    /// <summary>
+    /// Stores the prepared call sites and resolves them from their handle.
+    /// A method is registered only once, so preparing the same method many times returns the same handle.
+    /// </summary>
+    public static class CallSiteTable
+    {
+        private static readonly object locker = new object();
+        private static readonly Dictionary<MethodInfo, CallSite> byMethod = new Dictionary<MethodInfo, CallSite>();
+        private static CallSite[] sites = new CallSite[64];
+        private static int count;
+
+        public static CallSite Register(Type type, MethodInfo method)
+        {
+            lock (locker)
+            {
+                if (byMethod.TryGetValue(method, out var site))
+                    return site;
+
+                if (count == sites.Length)
+                    Array.Resize(ref sites, count * 2);
+
+                site = new CallSite(count, type, method);
+                sites[count++] = site;
+                byMethod.Add(method, site);
+                return site;
+            }
+        }
+
+        public static bool TryGet(int handle, out CallSite site)
+        {
+            // The array is only replaced by a bigger copy, so a lock free read is safe
+            var snapshot = sites;
+            if (handle < 0 || handle >= snapshot.Length)
+            {
+                site = null;
+                return false;
+            }
+
+            site = snapshot[handle];
+            return site != null;
+        }
+    }
+}
@@ -0,0 +1,166 @@
+﻿using System;
+using System.Linq.Expressions;
+using System.Reflection;
+using System.Runtime.InteropServices;
+
+namespace Sharper.CallSites
+{
+    /// <summary>
+    /// The kinds of the scalar values exchanged without any converter, shared with the native host.
+    /// </summary>
+    public enum ScalarKind
+    {
+        /// <summary>No value, only for a returned type.</summary>
+        Void = 0,
+        /// <summary>A <see cref="double"/>, from and to an R numeric of length 1.</summary>
+        Double = 1,
+        /// <summary>An <see cref="int"/>, from and to an R integer of length 1.</summary>
+        Integer = 2,
+        /// <summary>A <see cref="bool"/>, from and to an R logical of length 1.</summary>
+        Logical = 3
+    }
+
+    /// <summary>
+    /// Invokes a method whose parameters and returned type are all scalars, from raw values instead of converters.
+    /// The native host reads each argument from its R vector into a 64 bits slot: the bits of a double, or an integer.
+    /// The result is written into the data of the R scalar which the native host allocated for it.
+    /// So a call neither converts, boxes nor allocates anything.
+    /// </summary>
+    /// <remarks>
+    /// The R values which the converters would read differently, i.e. NA, with attributes or of another type,
+    /// are detected by the native host which then calls the method through its converters.
+    /// </remarks>
+    public sealed class ScalarInvoker
+    {
+        private ScalarInvoker(ScalarKind returnKind, ScalarKind[] parameterKinds, Action<object, IntPtr, IntPtr> invoke)
+        {
+            ReturnKind = returnKind;
+            ParameterKinds = parameterKinds;
+            Invoke = invoke;
+        }
+
+        /// <summary>
+        /// Gets the kind of the returned value.
+        /// </summary>
+        public ScalarKind ReturnKind { get; }
+
+        /// <summary>
+        /// Gets the kind of each parameter.
+        /// </summary>
+        public ScalarKind[] ParameterKinds { get; }
+
+        /// <summary>
+        /// Invokes the method from its instance, null for a static method, the arguments slots and the result data.
+        /// </summary>
+        public Action<object, IntPtr, IntPtr> Invoke { get; }
+
+        /// <summary>
+        /// Creates an invoker if the method only takes and returns scalars.
+        /// </summary>
+        public static bool TryCreate(MethodInfo method, out ScalarInvoker invoker)
+        {
+            invoker = null;
+            if (method.ContainsGenericParameters
+                || !TryGetKind(method.ReturnType, true, out var returnKind))
+                return false;
+
+            var parameters = method.GetParameters();
+            var parameterKinds = new ScalarKind[parameters.Length];
+            for (var i = 0; i < parameters.Length; i++)
+            {
+                if (!TryGetKind(parameters[i].ParameterType, false, out parameterKinds[i]))
+                    return false;
+            }
+
+            try
+            {
+                invoker = new ScalarInvoker(returnKind, parameterKinds, Compile(method, returnKind, parameterKinds));
+                return true;
+            }
+            catch (Exception)
+            {
+                // Called through its converters instead
+                return false;
+            }
+        }
+
+        private static bool TryGetKind(Type type, bool isReturn, out ScalarKind kind)
+        {
+            if (type == typeof(double))
+                kind = ScalarKind.Double;
+            else if (type == typeof(int))
+                kind = ScalarKind.Integer;
+            else if (type == typeof(bool))
+                kind = ScalarKind.Logical;
+            else
+            {
+                kind = ScalarKind.Void;
+                return isReturn && type == typeof(void);
+            }
+
+            return true;
+        }
+
+        private static Action<object, IntPtr, IntPtr> Compile(MethodInfo method, ScalarKind returnKind, ScalarKind[] parameterKinds)
+        {
+            var instance = Expression.Parameter(typeof(object), "instance");
+            var args = Expression.Parameter(typeof(IntPtr), "args");
+            var result = Expression.Parameter(typeof(IntPtr), "result");
+
+            var readInt64 = typeof(Marshal).GetMethod(nameof(Marshal.ReadInt64), new[] { typeof(IntPtr), typeof(int) });
+            var arguments = new Expression[parameterKinds.Length];
+            for (var i = 0; i < arguments.Length; i++)
+            {
+                Expression slot = Expression.Call(readInt64, args, Expression.Constant(i * sizeof(long)));
+                switch (parameterKinds[i])
+                {
+                    case ScalarKind.Double:
+                        arguments[i] = Expression.Call(typeof(BitConverter).GetMethod(nameof(BitConverter.Int64BitsToDouble)), slot);
+                        break;
+                    case ScalarKind.Integer:
+                        arguments[i] = Expression.Convert(slot, typeof(int));
+                        break;
+                    default:
+                        arguments[i] = Expression.NotEqual(slot, Expression.Constant(0L));
+                        break;
+                }
+            }
+
+            Expression call;
+            if (method.IsStatic)
+                call = Expression.Call(method, arguments);
+            else
+            {
+                // A struct instance is called on its boxed value, as by the converters
+                var declaringType = method.DeclaringType;
+                var target = declaringType.IsValueType
+                    ? Expression.Unbox(instance, declaringType)
+                    : Expression.Convert(instance, declaringType);
+                call = Expression.Call(target, method, arguments);
+            }
+
+            // R stores a numeric as a double, an integer and a logical as an int
+            Expression body;
+            switch (returnKind)
+            {
+                case ScalarKind.Double:
+                    body = Expression.Call(typeof(Marshal).GetMethod(nameof(Marshal.WriteInt64), new[] { typeof(IntPtr), typeof(long) }),
+                        result, Expression.Call(typeof(BitConverter).GetMethod(nameof(BitConverter.DoubleToInt64Bits)), call));
+                    break;
+                case ScalarKind.Integer:
+                    body = Expression.Call(typeof(Marshal).GetMethod(nameof(Marshal.WriteInt32), new[] { typeof(IntPtr), typeof(int) }),
+                        result, call);
+                    break;
+                case ScalarKind.Logical:
+                    body = Expression.Call(typeof(Marshal).GetMethod(nameof(Marshal.WriteInt32), new[] { typeof(IntPtr), typeof(int) }),
+                        result, Expression.Condition(call, Expression.Constant(1), Expression.Constant(0)));
+                    break;
+                default:
+                    body = call;
+                    break;
+            }
+
+            return Expression.Lambda<Action<object, IntPtr, IntPtr>>(body, instance, args, result).Compile();
+        }
+    }
+}
@@ -0,0 +1,146 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using System.Threading;
+
+namespace Sharper
+{
+    /// <summary>
+    /// Measures the time spent in each phase of the calls from R, by entry point and member.
+    /// The native host measures the whole calls, both are merged by the R function netStats.
+    /// Nothing is measured until it is enabled, a disabled measure costs only a flag check.
+    /// </summary>
+    public static class CallStatistics
+    {
+        private static readonly int phasesCount = Enum.GetValues(typeof(CallPhase)).Length;
+        private static readonly ConcurrentDictionary<(string, string, string), MemberStatistics> members = new ConcurrentDictionary<(string, string, string), MemberStatistics>();
+
+        [ThreadStatic] private static List<CallRecord> records;
+        [ThreadStatic] private static int depth;
+        private static volatile bool isEnabled;
+
+        public static bool IsEnabled
+        {
+            get => isEnabled;
+            set => isEnabled = value;
+        }
+
+        /// <summary>
+        /// Starts to measure a call. A call from R can be nested when .Net calls back R.
+        /// </summary>
+        internal static void Begin(string entryPoint, string typeName, string memberName)
+        {
+            if (!isEnabled) return;
+
+            var stack = records ?? (records = new List<CallRecord>());
+            if (depth == stack.Count)
+                stack.Add(new CallRecord(phasesCount));
+            stack[depth++].Begin(entryPoint, typeName, memberName);
+        }
+
+        /// <summary>
+        /// Accounts the time since the previous mark to a phase of the current call.
+        /// </summary>
+        internal static void Mark(CallPhase phase)
+        {
+            if (!isEnabled || depth == 0) return;
+
+            records[depth - 1].Mark(phase);
+        }
+
+        /// <summary>
+        /// Stops to measure the current call and records it.
+        /// </summary>
+        internal static void End()
+        {
+            if (depth == 0) return;
+
+            var record = records[--depth];
+            if (!isEnabled) return;
+
+            var key = (record.EntryPoint, record.TypeName ?? string.Empty, record.MemberName ?? string.Empty);
+            if (!members.TryGetValue(key, out var statistics))
+                statistics = members.GetOrAdd(key, new MemberStatistics(phasesCount));
+
+            statistics.Add(record);
+        }
+
+        public static void Reset() => members.Clear();
+
+        /// <summary>
+        /// Gets the statistics as columns, with the phases times in milliseconds.
+        /// </summary>
+        public static Dictionary<string, object> GetStatistics()
+        {
+            var snapshot = members.ToArray();
+            var result = new Dictionary<string, object>
+            {
+                { "entry_point", snapshot.Select(p => p.Key.Item1).ToArray() },
+                { "type", snapshot.Select(p => p.Key.Item2).ToArray() },
+                { "member", snapshot.Select(p => p.Key.Item3).ToArray() },
+                { "managed_calls", snapshot.Select(p => (double)Interlocked.Read(ref p.Value.Calls)).ToArray() },
+            };
+
+            foreach (CallPhase phase in Enum.GetValues(typeof(CallPhase)))
+            {
+                var index = (int)phase;
+                result.Add(phase.ToString().ToLowerInvariant() + "_ms", snapshot.Select(p => ToMilliseconds(Interlocked.Read(ref p.Value.Ticks[index]))).ToArray());
+            }
+
+            return result;
+        }
+
+        private static double ToMilliseconds(long ticks) => ticks * 1000.0 / Stopwatch.Frequency;
+
+        private class CallRecord
+        {
+            private long _last;
+
+            public CallRecord(int phasesCount)
+            {
+                Ticks = new long[phasesCount];
+            }
+
+            public string EntryPoint { get; private set; }
+            public string TypeName { get; private set; }
+            public string MemberName { get; private set; }
+            public long[] Ticks { get; }
+
+            public void Begin(string entryPoint, string typeName, string memberName)
+            {
+                EntryPoint = entryPoint;
+                TypeName = typeName;
+                MemberName = memberName;
+                Array.Clear(Ticks, 0, Ticks.Length);
+                _last = Stopwatch.GetTimestamp();
+            }
+
+            public void Mark(CallPhase phase)
+            {
+                var now = Stopwatch.GetTimestamp();
+                Ticks[(int)phase] += now - _last;
+                _last = now;
+            }
+        }
+
+        private class MemberStatistics
+        {
+            public long Calls;
+            public readonly long[] Ticks;
+
+            public MemberStatistics(int phasesCount)
+            {
+                Ticks = new long[phasesCount];
+            }
+
+            public void Add(CallRecord record)
+            {
+                Interlocked.Increment(ref Calls);
+                for (var i = 0; i < Ticks.Length; i++)
+                    Interlocked.Add(ref Ticks[i], record.Ticks[i]);
+            }
+        }
+    }
+}
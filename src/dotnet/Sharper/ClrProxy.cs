@@ -5,6 +5,7 @@ using System.Reflection;
 using System.Runtime.InteropServices;
 using System.Security.Principal;
 using System.Text;
+using Sharper.CallSites;
 using Sharper.Converters;
 using Sharper.Converters.RDotNet;
 using Sharper.Loggers;
@@ -14,7 +15,7 @@ namespace Sharper
 {
     public static class ClrProxy
     {
-        private static readonly ILogger logger = new FileLogger(Assembly.GetExecutingAssembly().Location);
+        private static readonly ILogger logger = LogManager.CreateLogger(Assembly.GetExecutingAssembly().Location);
 
         static ClrProxy()
         {
@@ -60,6 +61,23 @@ namespace Sharper
 
         #endregion
 
+        [return: MarshalAs(UnmanagedType.Bool)]
+        public static bool RegisterNativeCallbacks(IntPtr allocVector, IntPtr callCompleted, IntPtr allocArrowBatch)
+        {
+            logger.InfoFormat("[RegisterNativeCallbacks] AllocVector: {0}, CallCompleted: {1}, AllocArrowBatch: {2}", allocVector, callCompleted, allocArrowBatch);
+
+            try
+            {
+                NativeCallbacks.Register(allocVector, callCompleted, allocArrowBatch);
+                return true;
+            }
+            catch (Exception e)
+            {
+                LogExceptions("[RegisterNativeCallbacks]", e);
+                return false;
+            }
+        }
+
         [return: MarshalAs(UnmanagedType.Bool)]
         public static bool LoadAssembly([MarshalAs(UnmanagedType.LPStr)] string pathOrAssemblyName)
         {
@@ -74,11 +92,8 @@ namespace Sharper
                 if (File.Exists(filePath))
                 {
                     var assemblyName = new FileInfo(filePath).Name;
-                    foreach (var assembly in AppDomain.CurrentDomain.GetAssemblies())
-                    {
-                        if (string.Equals(assembly.ManifestModule.Name, assemblyName))
-                            return true;
-                    }
+                    if (TypeIndex.TryGetAssemblyByFileName(assemblyName, out _))
+                        return true;
                     
                     Assembly.LoadFrom(filePath);
                     return true;
@@ -100,41 +115,48 @@ namespace Sharper
         }
 
         [return: MarshalAs(UnmanagedType.Bool)]
-        public static bool CallStaticMethod(
+        public static unsafe bool CallStaticMethod(
             [MarshalAs(UnmanagedType.LPStr)] string typeName,
             [MarshalAs(UnmanagedType.LPStr)] string methodName,
-            [MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 3)] long[] argumentsPtr,
+            long* argumentsPtr,
+            long* argumentsData,
             int argumentsSize,
-            [Out, MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 5)] out long[] results,
+            long* results,
+            int resultsCapacity,
             [Out] out int resultsSize)
         {
             const BindingFlags flags = BindingFlags.Public | BindingFlags.Static;
 
             logger.DebugFormat("[CallStaticMethod] TypeName: {0}, MethodName: {1}, NbArguments: {2}", typeName, methodName, argumentsSize);
+            CallStatistics.Begin("CallStaticMethod", typeName, methodName);
 
             try
             {
                 if (!typeName.TryGetType(out var type, out var errorMsg))
                     throw new TypeAccessException(errorMsg);
+                CallStatistics.Mark(CallPhase.Resolution);
 
-                var converters = new IConverter[argumentsSize];
-                for (var i = 0; i < argumentsSize; i++)
-                    converters[i] = DataConverter.GetConverter(argumentsPtr[i]);
+                var converters = GetConverters(argumentsPtr, argumentsData, argumentsSize);
+                CallStatistics.Mark(CallPhase.Conversion);
 
                 if (!type.TryGetMethod(methodName, flags, converters, out var method))
                     throw new MissingMethodException($"Method not found, Type: {typeName}, Method: {methodName}");
+                CallStatistics.Mark(CallPhase.Resolution);
 
-                InternalCallMethod(method, null, converters, out results, out resultsSize);
+                InternalCallMethod(method, null, converters, results, resultsCapacity, out resultsSize);
 
                 return true;
             }
             catch (Exception e)
             {
                 LogExceptions("[CallStaticMethod]", e);
-                results = null;
                 resultsSize = 0;
                 return false;
             }
+            finally
+            {
+                CallStatistics.End();
+            }
         }
 
         [return: MarshalAs(UnmanagedType.Bool)]
@@ -144,6 +166,7 @@ namespace Sharper
             [Out, MarshalAs(UnmanagedType.U8)] out long value)
         {
             logger.DebugFormat("[GetStaticProperty] TypeName: {0}, PropertyName: {1}", typeName, propertyName);
+            CallStatistics.Begin("GetStaticProperty", typeName, propertyName);
 
             try
             {
@@ -155,9 +178,11 @@ namespace Sharper
                     throw new MissingMemberException($"Static property {propertyName} not found for Type: {type.FullName}");
                 if (!property.CanRead)
                     throw new InvalidOperationException($"Static property {propertyName} can't be get for Type: {type.FullName}");
+                CallStatistics.Mark(CallPhase.Resolution);
 
                 var result = property.GetGetMethod().Call(null, new IConverter[0])[0];
                 value = DataConverter.ConvertBack(property.PropertyType, result);
+                CallStatistics.Mark(CallPhase.Wrapping);
 
                 return true;
             }
@@ -167,6 +192,10 @@ namespace Sharper
                 value = 0;
                 return false;
             }
+            finally
+            {
+                CallStatistics.End();
+            }
         }
 
         [return: MarshalAs(UnmanagedType.Bool)]
@@ -176,6 +205,7 @@ namespace Sharper
             [MarshalAs(UnmanagedType.U8)] long argumentPtr)
         {
             logger.DebugFormat("[SetStaticProperty] TypeName: {0}, PropertyName: {1}", typeName, propertyName);
+            CallStatistics.Begin("SetStaticProperty", typeName, propertyName);
 
             try
             {
@@ -187,6 +217,7 @@ namespace Sharper
                     throw new MissingMemberException($"Static property {propertyName} not found for Type: {type.FullName}");
                 if (!property.CanWrite)
                     throw new InvalidOperationException($"Static property {propertyName} can't be set for Type: {type.FullName}");
+                CallStatistics.Mark(CallPhase.Resolution);
 
                 var converters = new[] { DataConverter.GetConverter(argumentPtr) };
 
@@ -198,31 +229,39 @@ namespace Sharper
                 LogExceptions("[SetStaticProperty]", e);
                 return false;
             }
+            finally
+            {
+                CallStatistics.End();
+            }
         }
 
         [return: MarshalAs(UnmanagedType.Bool)]
-        public static bool CreateObject(
+        public static unsafe bool CreateObject(
             [MarshalAs(UnmanagedType.LPStr)] string typeName,
-            [MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 2)] long[] argumentsPtr,
+            long* argumentsPtr,
+            long* argumentsData,
             int argumentsSize,
             [Out, MarshalAs(UnmanagedType.U8)] out long objectPtr)
         {
             logger.DebugFormat("[CreateInstance] TypeName: {0}", typeName);
+            CallStatistics.Begin("CreateObject", typeName, null);
 
             try
             {
                 if (!typeName.TryGetType(out var type, out var errorMsg))
                     throw new TypeAccessException(errorMsg);
+                CallStatistics.Mark(CallPhase.Resolution);
 
-                var converters = new IConverter[argumentsSize];
-                for (var i = 0; i < argumentsSize; i++)
-                    converters[i] = DataConverter.GetConverter(argumentsPtr[i]);
+                var converters = GetConverters(argumentsPtr, argumentsData, argumentsSize);
+                CallStatistics.Mark(CallPhase.Conversion);
 
                 if (!type.TryGetConstructor(converters, out var ctor))
                     throw new MissingMemberException($"Constructor not found for Type: {typeName}");
+                CallStatistics.Mark(CallPhase.Resolution);
 
                 var result = ctor.Call(converters);
                 objectPtr = DataConverter.ConvertBack(type, result);
+                CallStatistics.Mark(CallPhase.Wrapping);
                 return true;
             }
             catch (Exception e)
@@ -231,36 +270,58 @@ namespace Sharper
                 objectPtr = 0;
                 return false;
             }
+            finally
+            {
+                CallStatistics.End();
+            }
         }
 
+        /// <summary>
+        /// Releases the .Net objects collected by R, by their handles queued from the R finalizers.
+        /// A stale handle doesn't stop the others to be released.
+        /// </summary>
         [return: MarshalAs(UnmanagedType.Bool)]
-        public static bool ReleaseObject([MarshalAs(UnmanagedType.U8)] long objectPtr)
+        public static unsafe bool ReleaseObjects(long* handles, int count)
         {
-            logger.Debug("[ReleaseObject]");
-            try
-            {
-                DataConverter.Release(objectPtr);
-                return true;
-            }
-            catch (Exception e)
+            logger.DebugFormat("[ReleaseObjects] Count: {0}", count);
+
+            var failures = 0;
+            Exception failure = null;
+            for (var i = 0; i < count; i++)
             {
-                LogExceptions("[ReleaseObject]", e);
-                return false;
+                try
+                {
+                    ObjectTable.Release(new IntPtr(handles[i]));
+                }
+                catch (Exception e)
+                {
+                    failures++;
+                    failure = e;
+                }
             }
+
+            if (failure == null) return true;
+
+            // Only logged, the release can run from an R finalizer during another call which owns the last error
+            logger.Error($"[ReleaseObjects] {failures} of {count} objects", failure);
+            return false;
         }
 
         [return: MarshalAs(UnmanagedType.Bool)]
-        public static bool CallMethod(
+        public static unsafe bool CallMethod(
             [MarshalAs(UnmanagedType.U8)]  long objectPtr,
             [MarshalAs(UnmanagedType.LPStr)] string methodName,
-            [MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 3)] long[] argumentsPtr,
+            long* argumentsPtr,
+            long* argumentsData,
             int argumentsSize,
-            [Out, MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 5)] out long[] results,
+            long* results,
+            int resultsCapacity,
             [Out] out int resultsSize)
         {
             const BindingFlags flags = BindingFlags.Public | BindingFlags.Instance;
 
             logger.DebugFormat("[CallMethod] Instance: {0}, MethodName: {1}", objectPtr, methodName);
+            CallStatistics.Begin("CallMethod", null, methodName);
 
             try
             {
@@ -270,24 +331,27 @@ namespace Sharper
 
                 var type = instance.GetType();
 
-                var converters = new IConverter[argumentsSize];
-                for (var i = 0; i < argumentsSize; i++)
-                    converters[i] = DataConverter.GetConverter(argumentsPtr[i]);
+                var converters = GetConverters(argumentsPtr, argumentsData, argumentsSize);
+                CallStatistics.Mark(CallPhase.Conversion);
 
                 if (!type.TryGetMethod(methodName, flags, converters, out var method))
                     throw new MissingMethodException($"Method not found for Type: {type}, Method: {methodName}");
+                CallStatistics.Mark(CallPhase.Resolution);
 
-                InternalCallMethod(method, instance, converters, out results, out resultsSize);
+                InternalCallMethod(method, instance, converters, results, resultsCapacity, out resultsSize);
 
                 return true;
             }
             catch (Exception e)
             {
                 LogExceptions("[CallMethod]", e);
-                results = null;
                 resultsSize = 0;
                 return false;
             }
+            finally
+            {
+                CallStatistics.End();
+            }
         }
 
         [return: MarshalAs(UnmanagedType.Bool)]
@@ -297,6 +361,7 @@ namespace Sharper
             [Out, MarshalAs(UnmanagedType.U8)] out long value)
         {
             logger.DebugFormat("[GetProperty] Instance: {0}, PropertyName: {1}", objectPtr, propertyName);
+            CallStatistics.Begin("GetProperty", null, propertyName);
 
             try
             {
@@ -312,9 +377,11 @@ namespace Sharper
 
                 if (!property.CanRead)
                     throw new InvalidOperationException($"Property {propertyName} can't be get for Type: {type.FullName}");
+                CallStatistics.Mark(CallPhase.Resolution);
 
                 var result = property.GetGetMethod().Call(instance, new IConverter[0])[0];
                 value = DataConverter.ConvertBack(property.PropertyType, result);
+                CallStatistics.Mark(CallPhase.Wrapping);
                 return true;
             }
             catch (Exception e)
@@ -323,6 +390,10 @@ namespace Sharper
                 value = 0;
                 return false;
             }
+            finally
+            {
+                CallStatistics.End();
+            }
         }
 
         [return: MarshalAs(UnmanagedType.Bool)]
@@ -332,6 +403,7 @@ namespace Sharper
             [MarshalAs(UnmanagedType.U8)] long argumentPtr)
         {
             logger.DebugFormat("[SetProperty] Instance: {0}, PropertyName: {1}", objectPtr, propertyName);
+            CallStatistics.Begin("SetProperty", null, propertyName);
 
             try
             {
@@ -347,6 +419,7 @@ namespace Sharper
 
                 if (!property.CanWrite)
                     throw new InvalidOperationException($"Property {propertyName} can't be set for Type: {type.FullName}");
+                CallStatistics.Mark(CallPhase.Resolution);
 
                 var converters = new[] { DataConverter.GetConverter(argumentPtr) };
 
@@ -358,21 +431,530 @@ namespace Sharper
                 LogExceptions("[SetProperty]", e);
                 return false;
             }
+            finally
+            {
+                CallStatistics.End();
+            }
+        }
+
+        [return: MarshalAs(UnmanagedType.Bool)]
+        public static bool PrepareMethod(
+            [MarshalAs(UnmanagedType.LPStr)] string typeName,
+            [MarshalAs(UnmanagedType.U8)] long objectPtr,
+            [MarshalAs(UnmanagedType.Bool)] bool isStatic,
+            [MarshalAs(UnmanagedType.LPStr)] string methodName,
+            IntPtr argumentTypeNames,
+            int argumentTypesSize,
+            [Out] out int handle)
+        {
+            logger.DebugFormat("[PrepareMethod] TypeName: {0}, Instance: {1}, Static: {2}, MethodName: {3}", typeName, objectPtr, isStatic, methodName);
+
+            try
+            {
+                Type type;
+                BindingFlags flags;
+                if (typeName != null)
+                {
+                    if (!typeName.TryGetType(out type, out var errorMsg))
+                        throw new TypeAccessException(errorMsg);
+                    // An instance method prepared from its type name can be called on any instance of this type
+                    flags = BindingFlags.Public | (isStatic ? BindingFlags.Static : BindingFlags.Instance);
+                }
+                else
+                {
+                    var instance = DataConverter.GetConverter(objectPtr)?.Convert(typeof(object));
+                    if (instance == null)
+                        throw new ArgumentNullException(nameof(objectPtr));
+                    type = instance.GetType();
+                    flags = BindingFlags.Public | BindingFlags.Instance;
+                }
+
+                // A negative size means that the argument types aren't specified
+                Type[] parameterTypes = null;
+                if (argumentTypesSize >= 0)
+                {
+                    parameterTypes = new Type[argumentTypesSize];
+                    for (var i = 0; i < argumentTypesSize; i++)
+                    {
+                        var parameterTypeName = Marshal.PtrToStringAnsi(Marshal.ReadIntPtr(argumentTypeNames, i * IntPtr.Size));
+                        if (!parameterTypeName.TryGetParameterType(out parameterTypes[i], out var errorMsg))
+                            throw new TypeAccessException(errorMsg);
+                    }
+                }
+
+                if (!type.TryGetMethod(methodName, flags, parameterTypes, out var method, out var error))
+                    throw new MissingMethodException(error);
+
+                handle = CallSiteTable.Register(type, method).Handle;
+                return true;
+            }
+            catch (Exception e)
+            {
+                LogExceptions("[PrepareMethod]", e);
+                handle = -1;
+                return false;
+            }
+        }
+
+        [return: MarshalAs(UnmanagedType.Bool)]
+        public static unsafe bool CallPreparedMethod(
+            int handle,
+            [MarshalAs(UnmanagedType.U8)] long objectPtr,
+            long* argumentsPtr,
+            long* argumentsData,
+            int argumentsSize,
+            long* results,
+            int resultsCapacity,
+            [Out] out int resultsSize)
+        {
+            logger.DebugFormat("[CallPreparedMethod] Handle: {0}, Instance: {1}, NbArguments: {2}", handle, objectPtr, argumentsSize);
+            // The native host only knows the call site handle
+            CallStatistics.Begin("CallPreparedMethod", null, CallStatistics.IsEnabled ? "#" + handle : null);
+
+            try
+            {
+                if (!CallSiteTable.TryGet(handle, out var site))
+                    throw new ArgumentOutOfRangeException(nameof(handle), $"Unknown call site handle: {handle}");
+
+                var instance = GetInstance(site, objectPtr);
+
+                if (argumentsSize != site.Parameters.Length)
+                    throw new TargetParameterCountException($"{site} expects {site.Parameters.Length} arguments but {argumentsSize} have been given");
+
+                CallStatistics.Mark(CallPhase.Resolution);
+
+                var converters = GetConverters(argumentsPtr, argumentsData, argumentsSize);
+                CallStatistics.Mark(CallPhase.Conversion);
+
+                InternalCallMethod(site.Method, instance, converters, results, resultsCapacity, out resultsSize);
+
+                return true;
+            }
+            catch (Exception e)
+            {
+                LogExceptions("[CallPreparedMethod]", e);
+                resultsSize = 0;
+                return false;
+            }
+            finally
+            {
+                CallStatistics.End();
+            }
+        }
+
+        [return: MarshalAs(UnmanagedType.Bool)]
+        public static unsafe bool GetScalarSignature(
+            int handle,
+            int* kinds,
+            int capacity,
+            [Out] out int size)
+        {
+            logger.DebugFormat("[GetScalarSignature] Handle: {0}", handle);
+
+            try
+            {
+                if (!CallSiteTable.TryGet(handle, out var site))
+                    throw new ArgumentOutOfRangeException(nameof(handle), $"Unknown call site handle: {handle}");
+
+                // The returned kind then the parameters ones, nothing if the method isn't scalar
+                var scalar = site.Scalar;
+                if (scalar == null || scalar.ParameterKinds.Length + 1 > capacity)
+                {
+                    size = 0;
+                    return true;
+                }
+
+                kinds[0] = (int)scalar.ReturnKind;
+                for (var i = 0; i < scalar.ParameterKinds.Length; i++)
+                    kinds[i + 1] = (int)scalar.ParameterKinds[i];
+                size = scalar.ParameterKinds.Length + 1;
+                return true;
+            }
+            catch (Exception e)
+            {
+                LogExceptions("[GetScalarSignature]", e);
+                size = 0;
+                return false;
+            }
+        }
+
+        [return: MarshalAs(UnmanagedType.Bool)]
+        public static unsafe bool CallPreparedScalar(
+            int handle,
+            [MarshalAs(UnmanagedType.U8)] long objectPtr,
+            long* arguments,
+            int argumentsSize,
+            void* result)
+        {
+            // Not logged, the debug log would box its arguments on each call
+            CallStatistics.Begin("CallPreparedScalar", null, CallStatistics.IsEnabled ? "#" + handle : null);
+
+            try
+            {
+                if (!CallSiteTable.TryGet(handle, out var site) || site.Scalar == null)
+                    throw new ArgumentOutOfRangeException(nameof(handle), $"Unknown scalar call site handle: {handle}");
+
+                var instance = GetInstance(site, objectPtr);
+
+                if (argumentsSize != site.Parameters.Length)
+                    throw new TargetParameterCountException($"{site} expects {site.Parameters.Length} arguments but {argumentsSize} have been given");
+
+                CallStatistics.Mark(CallPhase.Resolution);
+
+                site.Scalar.Invoke(instance, (IntPtr)arguments, (IntPtr)result);
+                CallStatistics.Mark(CallPhase.Invocation);
+
+                return true;
+            }
+            catch (Exception e)
+            {
+                LogExceptions("[CallPreparedScalar]", e);
+                return false;
+            }
+            finally
+            {
+                CallStatistics.End();
+            }
+        }
+
+        private static object GetInstance(CallSite site, long objectPtr)
+        {
+            if (site.IsStatic) return null;
+
+            var instance = objectPtr == 0 ? null : DataConverter.GetConverter(objectPtr)?.Convert(typeof(object));
+            if (instance == null)
+                throw new ArgumentNullException(nameof(objectPtr), $"An instance is required to call {site}");
+            if (!site.Method.DeclaringType?.IsInstanceOfType(instance) ?? false)
+                throw new InvalidCastException($"Instance of type {instance.GetType().FullName} can't be used to call {site}");
+            return instance;
+        }
+
+        [return: MarshalAs(UnmanagedType.Bool)]
+        public static unsafe bool CallStaticMethodBatch(
+            [MarshalAs(UnmanagedType.LPStr)] string typeName,
+            [MarshalAs(UnmanagedType.LPStr)] string methodName,
+            int count,
+            [MarshalAs(UnmanagedType.Bool)] bool simplify,
+            long* argumentsPtr,
+            long* argumentsData,
+            int argumentsSize,
+            [Out, MarshalAs(UnmanagedType.U8)] out long result)
+        {
+            const BindingFlags flags = BindingFlags.Public | BindingFlags.Static;
+
+            logger.DebugFormat("[CallStaticMethodBatch] TypeName: {0}, MethodName: {1}, NbCalls: {2}", typeName, methodName, count);
+            CallStatistics.Begin("CallStaticMethodBatch", typeName, methodName);
+
+            try
+            {
+                if (!typeName.TryGetType(out var type, out var errorMsg))
+                    throw new TypeAccessException(errorMsg);
+                CallStatistics.Mark(CallPhase.Resolution);
+
+                var batch = CreateBatchCall(methodName, flags, count, argumentsPtr, argumentsData, argumentsSize);
+                var results = batch.Call(type, simplify);
+
+                result = results == null ? 0 : DataConverter.ConvertBack(results.GetType(), results);
+                CallStatistics.Mark(CallPhase.Wrapping);
+                return true;
+            }
+            catch (Exception e)
+            {
+                LogExceptions("[CallStaticMethodBatch]", e);
+                result = 0;
+                return false;
+            }
+            finally
+            {
+                CallStatistics.End();
+            }
+        }
+
+        [return: MarshalAs(UnmanagedType.Bool)]
+        public static unsafe bool CallMethodBatch(
+            [MarshalAs(UnmanagedType.U8)] long objectsPtr,
+            [MarshalAs(UnmanagedType.LPStr)] string methodName,
+            int count,
+            [MarshalAs(UnmanagedType.Bool)] bool simplify,
+            long* argumentsPtr,
+            long* argumentsData,
+            int argumentsSize,
+            [Out, MarshalAs(UnmanagedType.U8)] out long result)
+        {
+            const BindingFlags flags = BindingFlags.Public | BindingFlags.Instance;
+
+            logger.DebugFormat("[CallMethodBatch] MethodName: {0}, NbCalls: {1}", methodName, count);
+            CallStatistics.Begin("CallMethodBatch", null, methodName);
+
+            try
+            {
+                var instances = (object[])DataConverter.GetConverter(objectsPtr).Convert(typeof(object[]));
+
+                var batch = CreateBatchCall(methodName, flags, count, argumentsPtr, argumentsData, argumentsSize);
+                var results = batch.Call(instances, simplify);
+
+                result = results == null ? 0 : DataConverter.ConvertBack(results.GetType(), results);
+                CallStatistics.Mark(CallPhase.Wrapping);
+                return true;
+            }
+            catch (Exception e)
+            {
+                LogExceptions("[CallMethodBatch]", e);
+                result = 0;
+                return false;
+            }
+            finally
+            {
+                CallStatistics.End();
+            }
         }
 
-        private static void InternalCallMethod(MethodInfo method, object instance, IConverter[] converters, out long[] results, out int resultsSize)
+        [return: MarshalAs(UnmanagedType.Bool)]
+        public static unsafe bool CallStaticMethodAsync(
+            [MarshalAs(UnmanagedType.LPStr)] string typeName,
+            [MarshalAs(UnmanagedType.LPStr)] string methodName,
+            long* argumentsPtr,
+            long* argumentsData,
+            int argumentsSize,
+            [Out] out int handle)
+        {
+            const BindingFlags flags = BindingFlags.Public | BindingFlags.Static;
+
+            logger.DebugFormat("[CallStaticMethodAsync] TypeName: {0}, MethodName: {1}, NbArguments: {2}", typeName, methodName, argumentsSize);
+            CallStatistics.Begin("CallStaticMethodAsync", typeName, methodName);
+
+            try
+            {
+                if (!typeName.TryGetType(out var type, out var errorMsg))
+                    throw new TypeAccessException(errorMsg);
+                CallStatistics.Mark(CallPhase.Resolution);
+
+                var converters = GetConverters(argumentsPtr, argumentsData, argumentsSize);
+                CallStatistics.Mark(CallPhase.Conversion);
+
+                if (!type.TryGetMethod(methodName, flags, converters, out var method))
+                    throw new MissingMethodException($"Method not found, Type: {typeName}, Method: {methodName}");
+                CallStatistics.Mark(CallPhase.Resolution);
+
+                handle = StartAsyncCall(method, null, converters);
+                return true;
+            }
+            catch (Exception e)
+            {
+                LogExceptions("[CallStaticMethodAsync]", e);
+                handle = 0;
+                return false;
+            }
+            finally
+            {
+                CallStatistics.End();
+            }
+        }
+
+        [return: MarshalAs(UnmanagedType.Bool)]
+        public static unsafe bool CallMethodAsync(
+            [MarshalAs(UnmanagedType.U8)] long objectPtr,
+            [MarshalAs(UnmanagedType.LPStr)] string methodName,
+            long* argumentsPtr,
+            long* argumentsData,
+            int argumentsSize,
+            [Out] out int handle)
+        {
+            const BindingFlags flags = BindingFlags.Public | BindingFlags.Instance;
+
+            logger.DebugFormat("[CallMethodAsync] Instance: {0}, MethodName: {1}", objectPtr, methodName);
+            CallStatistics.Begin("CallMethodAsync", null, methodName);
+
+            try
+            {
+                var instance = DataConverter.GetConverter(objectPtr)?.Convert(typeof(object));
+                if (instance == null)
+                    throw new ArgumentNullException(nameof(objectPtr));
+
+                var type = instance.GetType();
+
+                var converters = GetConverters(argumentsPtr, argumentsData, argumentsSize);
+                CallStatistics.Mark(CallPhase.Conversion);
+
+                if (!type.TryGetMethod(methodName, flags, converters, out var method))
+                    throw new MissingMethodException($"Method not found for Type: {type}, Method: {methodName}");
+                CallStatistics.Mark(CallPhase.Resolution);
+
+                handle = StartAsyncCall(method, instance, converters);
+                return true;
+            }
+            catch (Exception e)
+            {
+                LogExceptions("[CallMethodAsync]", e);
+                handle = 0;
+                return false;
+            }
+            finally
+            {
+                CallStatistics.End();
+            }
+        }
+
+        [return: MarshalAs(UnmanagedType.Bool)]
+        public static bool WaitCall(int handle, int timeout, [Out] out int completed)
+        {
+            logger.DebugFormat("[WaitCall] Handle: {0}, Timeout: {1}", handle, timeout);
+
+            try
+            {
+                if (!AsyncCallTable.TryGet(handle, out var call))
+                    throw new ArgumentOutOfRangeException(nameof(handle), $"Unknown async call handle: {handle}");
+
+                completed = call.Wait(timeout) ? 1 : 0;
+                return true;
+            }
+            catch (Exception e)
+            {
+                LogExceptions("[WaitCall]", e);
+                completed = 0;
+                return false;
+            }
+        }
+
+        [return: MarshalAs(UnmanagedType.Bool)]
+        public static unsafe bool AwaitCall(
+            int handle,
+            long* results,
+            int resultsCapacity,
+            [Out] out int resultsSize)
+        {
+            logger.DebugFormat("[AwaitCall] Handle: {0}", handle);
+
+            if (!AsyncCallTable.TryGet(handle, out var call))
+            {
+                LogExceptions("[AwaitCall]", new ArgumentOutOfRangeException(nameof(handle), $"Unknown async call handle: {handle}"));
+                resultsSize = 0;
+                return false;
+            }
+
+            CallStatistics.Begin("AwaitCall", call.Method.DeclaringType?.FullName, call.Method.Name);
+            try
+            {
+                var objects = call.GetResults();
+                CallStatistics.Mark(CallPhase.Invocation);
+
+                WriteResults(call.Method, call.ResultType, objects, results, resultsCapacity, out resultsSize);
+                return true;
+            }
+            catch (Exception e)
+            {
+                LogExceptions("[AwaitCall]", e);
+                resultsSize = 0;
+                return false;
+            }
+            finally
+            {
+                AsyncCallTable.Remove(handle);
+                CallStatistics.End();
+            }
+        }
+
+        [return: MarshalAs(UnmanagedType.Bool)]
+        public static bool ReleaseCall(int handle)
+        {
+            logger.DebugFormat("[ReleaseCall] Handle: {0}", handle);
+
+            // The call keeps running, only its results are dropped
+            AsyncCallTable.Remove(handle);
+            return true;
+        }
+
+        /// <summary>
+        /// Converts the arguments on the R thread then starts the call on the thread pool.
+        /// </summary>
+        private static int StartAsyncCall(MethodInfo method, object instance, IConverter[] converters)
+        {
+            var parameters = method.GetParameters();
+            var args = new object[converters.Length];
+            for (var i = 0; i < converters.Length; i++)
+            {
+                // The R vectors are only protected until the .External call returns
+                var parameterType = parameters[i].ParameterType.Extract();
+                if (parameterType.IsVectorView())
+                    throw new NotSupportedException($"The parameter {parameters[i].Name} views an R vector memory, which can't be used by an async call: {method}");
+
+                args[i] = converters[i].Convert(parameterType);
+            }
+            CallStatistics.Mark(CallPhase.Conversion);
+
+            var handle = AsyncCallTable.NewHandle();
+            AsyncCallTable.Add(new AsyncCall(handle, method, instance, args));
+            CallStatistics.Mark(CallPhase.Invocation);
+            return handle;
+        }
+
+        /// <summary>
+        /// Creates a batch call from the arguments given by the native host:
+        /// the arguments columns followed by the first call arguments to resolve the overload.
+        /// </summary>
+        private static unsafe BatchCall CreateBatchCall(string methodName, BindingFlags flags, int count, long* argumentsPtr, long* argumentsData, int argumentsSize)
+        {
+            if (argumentsSize % 2 != 0)
+                throw new ArgumentException($"Expected the arguments columns followed by the first call arguments, got {argumentsSize} arguments");
+
+            var converters = GetConverters(argumentsPtr, argumentsData, argumentsSize);
+            CallStatistics.Mark(CallPhase.Conversion);
+            var size = argumentsSize / 2;
+            var columns = new IConverter[size];
+            var firsts = new IConverter[size];
+            Array.Copy(converters, 0, columns, 0, size);
+            Array.Copy(converters, size, firsts, 0, size);
+
+            return new BatchCall(DataConverter, methodName, flags, columns, firsts, count);
+        }
+
+        /// <summary>
+        /// Gets the arguments converters. The arguments data are the data pointer and length pairs
+        /// given by the native host to bind the R vectors memory without any copy.
+        /// </summary>
+        private static unsafe IConverter[] GetConverters(long* argumentsPtr, long* argumentsData, int argumentsSize)
+        {
+            var converters = new IConverter[argumentsSize];
+            for (var i = 0; i < argumentsSize; i++)
+            {
+                converters[i] = argumentsData != null
+                    ? DataConverter.GetConverter(argumentsPtr[i], argumentsData[2 * i], argumentsData[2 * i + 1])
+                    : DataConverter.GetConverter(argumentsPtr[i]);
+            }
+
+            return converters;
+        }
+
+        /// <summary>
+        /// Calls the method and writes the results into the buffer owned by the native host.
+        /// The first result is the returned value, then the out or ref arguments if any.
+        /// </summary>
+        private static unsafe void InternalCallMethod(MethodInfo method, object instance, IConverter[] converters, long* results, int resultsCapacity, out int resultsSize)
         {
             var objects = method.Call(instance, converters);
+            WriteResults(method, method.ReturnType, objects, results, resultsCapacity, out resultsSize);
+        }
+
+        /// <summary>
+        /// Converts back the returned value then the out or ref arguments into the buffer owned by the native host.
+        /// The returned value is converted from the given type, which is the task result type for an awaited task.
+        /// </summary>
+        private static unsafe void WriteResults(MethodInfo method, Type returnType, object[] objects, long* results, int resultsCapacity, out int resultsSize)
+        {
+            if (objects.Length > resultsCapacity)
+                throw new InvalidOperationException($"Results buffer too small for {method}, capacity: {resultsCapacity}, needed: {objects.Length}");
+
             resultsSize = objects.Length;
-            results = new long[resultsSize];
 
-            results[0] = DataConverter.ConvertBack(method.ReturnType, objects[0]);
+            results[0] = DataConverter.ConvertBack(returnType, objects[0]);
             if (resultsSize > 1)
             {
                 var parameters = method.GetParameters();
-                for (var i = 1; i < results.Length; i++)
+                for (var i = 1; i < resultsSize; i++)
                     results[i] = DataConverter.ConvertBack(parameters[i - 1].ParameterType.Extract(), objects[i]);
             }
+
+            CallStatistics.Mark(CallPhase.Wrapping);
         }
 
         // ReSharper disable once UnusedMember.Global
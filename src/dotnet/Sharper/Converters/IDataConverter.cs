@@ -8,6 +8,16 @@ namespace Sharper.Converters
 
         IConverter GetConverter(long pointer);
 
+        /// <summary>
+        /// Gets a converter which can also bind the data of a numeric, integer or logical vector without any copy.
+        /// The data of a character vector are its CHARSXP pointers.
+        /// </summary>
+        /// <param name="pointer">The R SEXP pointer.</param>
+        /// <param name="dataPointer">The pointer on the vector data, 0 if the SEXP isn't a vector.</param>
+        /// <param name="length">The vector length, or minus the number of columns of a data.frame, 
+        /// whose data pointer is then on the data pointer and length pairs of its columns.</param>
+        IConverter GetConverter(long pointer, long dataPointer, long length);
+
         long ConvertBack(Type type, object data);
 
         void Release(long pointer);
@@ -0,0 +1,62 @@
+﻿using System;
+
+namespace Sharper.Converters
+{
+    /// <summary>
+    /// Transposes a matrix between the column-major R layout and the row-major .Net layout.
+    /// </summary>
+    /// <remarks>
+    /// A naive transpose reads one side by a stride, which misses the cache on each element of a large matrix.
+    /// The matrix is transposed by square blocks instead, which both fit in the L1 cache, and each block row is unrolled.
+    /// </remarks>
+    internal static unsafe class MatrixTranspose
+    {
+        /// <summary>
+        /// The block side, a block of 32 x 32 doubles is 8 KB.
+        /// </summary>
+        public const int BlockSize = 32;
+
+        /// <summary>
+        /// Transposes a row-major matrix into another row-major matrix.
+        /// </summary>
+        /// <param name="source">The source, rows x columns.</param>
+        /// <param name="rows">The number of rows of the source.</param>
+        /// <param name="columns">The number of columns of the source.</param>
+        /// <param name="destination">The destination, columns x rows, which mustn't overlap the source.</param>
+        public static void Transpose<T>(T* source, int rows, int columns, T* destination) where T : unmanaged
+        {
+            // A single row or column has the same layout both ways
+            if (rows == 1 || columns == 1)
+            {
+                var length = (long)rows * columns;
+                Buffer.MemoryCopy(source, destination, length * sizeof(T), length * sizeof(T));
+                return;
+            }
+
+            for (var rowBlock = 0; rowBlock < rows; rowBlock += BlockSize)
+            {
+                var rowEnd = Math.Min(rowBlock + BlockSize, rows);
+                for (var columnBlock = 0; columnBlock < columns; columnBlock += BlockSize)
+                {
+                    var columnEnd = Math.Min(columnBlock + BlockSize, columns);
+                    for (var i = rowBlock; i < rowEnd; i++)
+                    {
+                        var from = source + (long)i * columns;
+                        var to = destination + i;
+
+                        var j = columnBlock;
+                        for (; j + 4 <= columnEnd; j += 4)
+                        {
+                            to[(long)j * rows] = from[j];
+                            to[(long)(j + 1) * rows] = from[j + 1];
+                            to[(long)(j + 2) * rows] = from[j + 2];
+                            to[(long)(j + 3) * rows] = from[j + 3];
+                        }
+                        for (; j < columnEnd; j++)
+                            to[(long)j * rows] = from[j];
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,67 @@
+﻿using System;
+
+namespace Sharper.Converters
+{
+    /// <summary>
+    /// Allocates R vectors to return large results without any copy.
+    /// A .Net method fills the returned <see cref="RVector{T}"/> in place and returns it,
+    /// then R gets the same vector. The allocation is only allowed from the R thread during a call from R.
+    /// </summary>
+    /// <example>
+    /// <code>
+    /// public static RVector&lt;double&gt; Prices(int count)
+    /// {
+    ///     var prices = RAllocator.Numeric(count);
+    ///     var span = prices.AsSpan();
+    ///     for (var i = 0; i &lt; span.Length; i++)
+    ///         span[i] = Price(i);
+    ///     return prices;
+    /// }
+    /// </code>
+    /// </example>
+    public static class RAllocator
+    {
+        private const int LGLSXP = 10;
+        private const int INTSXP = 13;
+        private const int REALSXP = 14;
+
+        public static RVector<double> Numeric(int length) => Alloc<double>(REALSXP, length);
+
+        public static RVector<int> Integer(int length) => Alloc<int>(INTSXP, length);
+
+        /// <summary>
+        /// Allocates a logical vector, R stores logical values as integers: 0 for FALSE, 1 for TRUE and <see cref="int.MinValue"/> for NA.
+        /// </summary>
+        public static RVector<int> Logical(int length) => Alloc<int>(LGLSXP, length);
+
+        /// <summary>
+        /// Allocates a numeric matrix, filled column after column as R stores it. It gets its dimensions once returned to R.
+        /// </summary>
+        public static RMatrix<double> NumericMatrix(int rowCount, int columnCount) => AllocMatrix<double>(REALSXP, rowCount, columnCount);
+
+        /// <summary>
+        /// Allocates an integer matrix, filled column after column as R stores it. It gets its dimensions once returned to R.
+        /// </summary>
+        public static RMatrix<int> IntegerMatrix(int rowCount, int columnCount) => AllocMatrix<int>(INTSXP, rowCount, columnCount);
+
+        private static RVector<T> Alloc<T>(int type, int length) where T : unmanaged
+        {
+            if (length < 0)
+                throw new ArgumentOutOfRangeException(nameof(length));
+
+            var sexp = NativeCallbacks.AllocVector(type, length, out var data);
+            return new RVector<T>(sexp, data, length);
+        }
+
+        private static RMatrix<T> AllocMatrix<T>(int type, int rowCount, int columnCount) where T : unmanaged
+        {
+            if (rowCount < 0)
+                throw new ArgumentOutOfRangeException(nameof(rowCount));
+            if (columnCount < 0)
+                throw new ArgumentOutOfRangeException(nameof(columnCount));
+
+            var sexp = NativeCallbacks.AllocVector(type, (long)rowCount * columnCount, out var data);
+            return new RMatrix<T>(sexp, data, rowCount, columnCount);
+        }
+    }
+}
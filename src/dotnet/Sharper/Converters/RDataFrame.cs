@@ -0,0 +1,110 @@
+﻿using System;
+using System.Collections.Generic;
+
+namespace Sharper.Converters
+{
+    /// <summary>
+    /// Columnar view of an R data.frame, each column is held in a typed array.
+    /// A data.frame argument is converted column by column with a single copy, and a returned frame
+    /// is converted back the same way, instead of boxing each value through a list of vectors.
+    /// </summary>
+    /// <remarks>
+    /// The columns types and their NA values:
+    /// <list type="bullet">
+    /// <item>numeric: <see cref="double"/>[], NA is <see cref="NaReal"/> which <see cref="double.IsNaN"/> matches.</item>
+    /// <item>integer: <see cref="int"/>[], NA is <see cref="NaInteger"/>.</item>
+    /// <item>logical: <see cref="Nullable{Boolean}"/>[], NA is null. A <see cref="bool"/>[] is also accepted back.</item>
+    /// <item>character and factor: <see cref="string"/>[], NA is null. A factor is given by its labels.</item>
+    /// <item>POSIXct: <see cref="Nullable{DateTime}"/>[], NA is null. A <see cref="DateTime"/>[] is also accepted back.</item>
+    /// </list>
+    /// </remarks>
+    public class RDataFrame
+    {
+        /// <summary>
+        /// The R NA for a numeric value, a NaN with the 1954 payload.
+        /// </summary>
+        public static readonly double NaReal = BitConverter.Int64BitsToDouble(0x7FF00000000007A2);
+
+        /// <summary>
+        /// The R NA for an integer value.
+        /// </summary>
+        public const int NaInteger = int.MinValue;
+
+        private static readonly HashSet<Type> columnTypes = new HashSet<Type>
+        {
+            typeof(double[]), typeof(int[]), typeof(bool[]), typeof(bool?[]),
+            typeof(string[]), typeof(DateTime[]), typeof(DateTime?[])
+        };
+
+        private readonly List<string> _names = new List<string>();
+        private readonly List<Array> _columns = new List<Array>();
+        private readonly Dictionary<string, int> _indexes = new Dictionary<string, int>();
+
+        public RDataFrame(int rowCount)
+        {
+            if (rowCount < 0)
+                throw new ArgumentOutOfRangeException(nameof(rowCount));
+
+            RowCount = rowCount;
+        }
+
+        /// <summary>
+        /// Gets the number of rows, which all the columns have.
+        /// </summary>
+        public int RowCount { get; }
+
+        public int ColumnCount => _columns.Count;
+
+        public IReadOnlyList<string> Names => _names;
+
+        public Array this[int index] => _columns[index];
+
+        public Array this[string name] => _columns[IndexOf(name)];
+
+        public bool Contains(string name) => _indexes.ContainsKey(name);
+
+        /// <summary>
+        /// Gets a column by its name.
+        /// </summary>
+        /// <typeparam name="T">The column element type.</typeparam>
+        /// <exception cref="KeyNotFoundException">The column doesn't exist.</exception>
+        /// <exception cref="InvalidCastException">The column has another type.</exception>
+        public T[] GetColumn<T>(string name)
+        {
+            var column = this[name];
+            return column as T[] ?? throw new InvalidCastException($"The column {name} is {column.GetType().Name}, not {typeof(T[]).Name}");
+        }
+
+        /// <summary>
+        /// Adds a column, which must have <see cref="RowCount"/> values and a supported type.
+        /// </summary>
+        /// <returns>The data frame, so the columns can be chained.</returns>
+        public RDataFrame Add(string name, Array column)
+        {
+            if (name == null)
+                throw new ArgumentNullException(nameof(name));
+            if (column == null)
+                throw new ArgumentNullException(nameof(column));
+            if (!columnTypes.Contains(column.GetType()))
+                throw new ArgumentException($"Unsupported column type: {column.GetType().Name}, column: {name}", nameof(column));
+            if (column.Length != RowCount)
+                throw new ArgumentException($"The column {name} has {column.Length} values, expected {RowCount}", nameof(column));
+            if (_indexes.ContainsKey(name))
+                throw new ArgumentException($"The column {name} already exists", nameof(name));
+
+            _indexes.Add(name, _columns.Count);
+            _names.Add(name);
+            _columns.Add(column);
+            return this;
+        }
+
+        private int IndexOf(string name)
+        {
+            if (!_indexes.TryGetValue(name, out var index))
+                throw new KeyNotFoundException($"Column not found: {name}");
+            return index;
+        }
+
+        public override string ToString() => $"RDataFrame[{RowCount} x {ColumnCount}]";
+    }
+}
@@ -0,0 +1,75 @@
+﻿using System;
+using Apache.Arrow;
+using Apache.Arrow.C;
+using RDotNet;
+using RDotNet.Internals;
+
+namespace Sharper.Converters.RDotNet
+{
+    /// <summary>
+    /// Converts an arrow RecordBatch or Table given by R into a <see cref="RecordBatch"/>, and back, through the Arrow C data interface.
+    /// The native host exports an R arrow argument into an external pointer tagged <see cref="ARROW_BATCH_TAG"/>,
+    /// which holds an ArrowSchema then an ArrowArray struct. The batch is moved from the structs, so its buffers aren't copied.
+    /// </summary>
+    public unsafe class ArrowBatchConverter : IConverter
+    {
+        public const string ARROW_BATCH_TAG = ".ArrowBatch";
+
+        private static readonly Type[] types = typeof(RecordBatch).GetFullHierarchy();
+
+        private readonly CArrowSchema* _schema;
+        private readonly CArrowArray* _array;
+        private RecordBatch _batch;
+
+        public ArrowBatchConverter(SymbolicExpression sexp)
+        {
+            var data = sexp.Engine.GetFunction<R_ExternalPtrAddr>()(sexp.DangerousGetHandle());
+            if (data == IntPtr.Zero)
+                throw new ObjectDisposedException("The arrow batch has already been released");
+
+            _schema = (CArrowSchema*)data;
+            _array = (CArrowArray*)(data + sizeof(CArrowSchema));
+        }
+
+        #region Implementation of IConverter
+
+        public Type[] GetClrTypes() => types;
+
+        public object Convert(Type type)
+        {
+            // The structs are moved by the import, so it's done once
+            if (_batch == null)
+            {
+                var schema = CArrowSchemaImporter.ImportSchema(_schema);
+                _batch = CArrowArrayImporter.ImportRecordBatch(_array, schema);
+            }
+
+            return _batch;
+        }
+
+        #endregion
+
+        public static bool IsArrowBatch(SymbolicExpression sexp)
+        {
+            var tagPtr = sexp.Engine.GetFunction<R_ExternalPtrTag>()(sexp.DangerousGetHandle());
+            var tag = sexp.Engine.CreateFromNativeSexp(tagPtr);
+
+            return tag.Type == SymbolicExpressionType.CharacterVector
+                && string.Equals(tag.AsCharacter()[0], ARROW_BATCH_TAG);
+        }
+
+        /// <summary>
+        /// Exports a record batch into structs allocated by the native host, which R imports as an arrow RecordBatch once the call returns.
+        /// The exported batch keeps its buffers alive until R releases it.
+        /// </summary>
+        public static SymbolicExpression ToSexp(REngine engine, RecordBatch batch)
+        {
+            var sexp = NativeCallbacks.AllocArrowBatch(out var schema, out var array);
+
+            CArrowSchemaExporter.ExportSchema(batch.Schema, (CArrowSchema*)schema);
+            CArrowArrayExporter.ExportRecordBatch(batch, (CArrowArray*)array);
+
+            return engine.CreateFromNativeSexp(sexp);
+        }
+    }
+}
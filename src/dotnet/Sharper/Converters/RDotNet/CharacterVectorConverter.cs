@@ -0,0 +1,63 @@
+﻿using System;
+using System.Collections;
+using System.Collections.Generic;
+using System.Linq;
+using RDotNet;
+
+namespace Sharper.Converters.RDotNet
+{
+    /// <summary>
+    /// Converts a character vector through the <see cref="StringCache"/>, so a repeated value gives the same .Net string decoded once.
+    /// An enum or an enum array is bound by the names of its values.
+    /// </summary>
+    public class CharacterVectorConverter : IConverter
+    {
+        private static readonly Type[] multiValues = { typeof(string[]), typeof(List<string>), typeof(IList<string>), typeof(ICollection<string>), typeof(IEnumerable<string>), typeof(Array), typeof(IEnumerable) };
+        private static readonly Type[] singleValue = new[] { typeof(string) }.Concat(multiValues).ToArray();
+
+        private readonly CharacterVector _sexp;
+        private readonly IntPtr _elements;
+        private readonly Type[] _types;
+        private string[] _values;
+
+        public CharacterVectorConverter(CharacterVector sexp)
+            : this(sexp, IntPtr.Zero) { }
+
+        /// <param name="sexp">The character vector.</param>
+        /// <param name="elements">The CHARSXP pointers given by the native host, or zero to read them one by one.</param>
+        public CharacterVectorConverter(CharacterVector sexp, IntPtr elements)
+        {
+            _sexp = sexp;
+            _elements = elements;
+            _types = sexp.Length <= 1
+                ? singleValue
+                : multiValues;
+        }
+
+        #region Implementation of IConverter
+
+        public Type[] GetClrTypes() => _types;
+
+        public object Convert(Type type)
+        {
+            if (type == typeof(string))
+                return Values.FirstOrDefault();
+            if (type == typeof(string[]) || type == typeof(Array) || type == typeof(IEnumerable))
+                return Values;
+            if (type == typeof(List<string>) || type == typeof(IList<string>) || type == typeof(ICollection<string>) || type == typeof(IEnumerable<string>))
+                return Values.ToList();
+            if (type.IsEnum)
+                return Enum.Parse(type, Values.FirstOrDefault() ?? throw new InvalidCastException($"NA isn't a {type.Name}"));
+            if (type.IsEnumArray())
+                return RFactor.Encode(Values).ToEnums(type.GetElementType());
+
+            throw new InvalidOperationException($"Unexpected type on converter from R: {_sexp.Type} to Clr: {type}");
+        }
+
+        #endregion
+
+        private string[] Values => _values ?? (_values = _elements != IntPtr.Zero
+            ? StringCache.Read(_sexp.Engine, _elements, _sexp.Length)
+            : StringCache.Read(_sexp));
+    }
+}
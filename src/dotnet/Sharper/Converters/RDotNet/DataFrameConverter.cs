@@ -0,0 +1,232 @@
+﻿using System;
+using System.Linq;
+using RDotNet;
+using RDotNet.Internals;
+using Sharper.Converters.Resources;
+
+namespace Sharper.Converters.RDotNet
+{
+    /// <summary>
+    /// Converts a data.frame into a <see cref="RDataFrame"/>, each column is copied once into a typed array.
+    /// The other types are delegated to a <see cref="ListConverter"/>, so a data.frame still binds a list or a dictionary of columns.
+    /// </summary>
+    public unsafe class DataFrameConverter : IConverter
+    {
+        private const int LGLSXP = 10;
+        private const int INTSXP = 13;
+        private const int REALSXP = 14;
+
+        private readonly GenericVector _sexp;
+        private readonly ListConverter _list;
+        private readonly long* _columnsData;
+        private readonly int _columnsCount;
+        private readonly Type[] _types;
+
+        public DataFrameConverter(GenericVector sexp, IDataConverter converter)
+            : this(sexp, converter, IntPtr.Zero, 0) { }
+
+        /// <param name="sexp">The data.frame.</param>
+        /// <param name="converter">The data converter, for the list conversions.</param>
+        /// <param name="columnsData">The data pointer and length pairs of the columns given by the native host,
+        /// the data pointer is 0 for a column which isn't a numeric, integer, logical or character vector.</param>
+        /// <param name="columnsCount">The number of pairs.</param>
+        public DataFrameConverter(GenericVector sexp, IDataConverter converter, IntPtr columnsData, int columnsCount)
+        {
+            _sexp = sexp;
+            _list = new ListConverter(sexp, converter);
+            _columnsData = (long*)columnsData;
+            _columnsCount = columnsData == IntPtr.Zero ? 0 : columnsCount;
+            _types = new[] { typeof(RDataFrame) }.Concat(_list.GetClrTypes()).ToArray();
+        }
+
+        #region Implementation of IConverter
+
+        public Type[] GetClrTypes() => _types;
+
+        public object Convert(Type type)
+        {
+            if (type == typeof(RDataFrame))
+                return ToDataFrame();
+
+            return _list.Convert(type);
+        }
+
+        #endregion
+
+        private RDataFrame ToDataFrame()
+        {
+            var columns = _sexp.ToArray();
+            var names = _sexp.Names;
+
+            var arrays = new Array[columns.Length];
+            var columnNames = new string[columns.Length];
+            for (var i = 0; i < columns.Length; i++)
+            {
+                columnNames[i] = names != null && i < names.Length && !string.IsNullOrEmpty(names[i]) ? names[i] : "V" + (i + 1);
+                arrays[i] = ReadColumn(columns[i], i, columnNames[i]);
+            }
+
+            // A data.frame without any column only knows its rows count by its row names
+            var rowCount = arrays.Length > 0
+                ? arrays[0].Length
+                : _sexp.GetAttribute("row.names")?.AsInteger().Length ?? 0;
+
+            var frame = new RDataFrame(rowCount);
+            for (var i = 0; i < arrays.Length; i++)
+                frame.Add(columnNames[i], arrays[i]);
+
+            return frame;
+        }
+
+        private Array ReadColumn(SymbolicExpression column, int index, string name)
+        {
+            switch (column.Type)
+            {
+                case SymbolicExpressionType.NumericVector:
+                    var values = ReadValues<double>(index) ?? column.AsNumeric().ToArray();
+                    return column.IsPosixct()
+                        ? ToDateTimes(values, column.GetWindowsTimezone())
+                        : (Array)values;
+                case SymbolicExpressionType.IntegerVector:
+                    var codes = ReadValues<int>(index) ?? column.AsInteger().ToArray();
+                    return column.IsFactor()
+                        ? ToLabels(codes, StringCache.Read(column.GetAttribute("levels").AsCharacter()))
+                        : (Array)codes;
+                case SymbolicExpressionType.LogicalVector:
+                    // Coerced as integers, so the NA are kept
+                    return ToBooleans(ReadValues<int>(index) ?? column.AsInteger().ToArray());
+                case SymbolicExpressionType.CharacterVector:
+                    return ReadStrings(index, column);
+                default:
+                    throw new NotSupportedException($"Unsupported data.frame column type: {column.Type}, column: {name}");
+            }
+        }
+
+        /// <summary>
+        /// Copies a column from the R memory given by the native host, null if it hasn't been given.
+        /// </summary>
+        private T[] ReadValues<T>(int index) where T : unmanaged
+        {
+            if (index >= _columnsCount || _columnsData[2 * index] == 0)
+                return null;
+
+            return new ReadOnlySpan<T>((void*)_columnsData[2 * index], (int)_columnsData[2 * index + 1]).ToArray();
+        }
+
+        /// <summary>
+        /// Reads a character column through the strings cache, from its CHARSXP pointers if the native host has given them.
+        /// </summary>
+        private string[] ReadStrings(int index, SymbolicExpression column)
+        {
+            if (index >= _columnsCount || _columnsData[2 * index] == 0)
+                return StringCache.Read(column.AsCharacter());
+
+            return StringCache.Read(column.Engine, new IntPtr(_columnsData[2 * index]), (int)_columnsData[2 * index + 1]);
+        }
+
+        private static DateTime?[] ToDateTimes(double[] ticks, TimeZoneInfo timezone)
+        {
+            var result = new DateTime?[ticks.Length];
+            for (var i = 0; i < ticks.Length; i++)
+            {
+                if (!double.IsNaN(ticks[i]))
+                    result[i] = ticks[i].FromTicks(timezone);
+            }
+            return result;
+        }
+
+        private static string[] ToLabels(int[] codes, string[] levels)
+        {
+            var result = new string[codes.Length];
+            for (var i = 0; i < codes.Length; i++)
+            {
+                // The codes start at 1, NA stays null
+                var code = codes[i];
+                if (code > 0 && code <= levels.Length)
+                    result[i] = levels[code - 1];
+            }
+            return result;
+        }
+
+        private static bool?[] ToBooleans(int[] values)
+        {
+            var result = new bool?[values.Length];
+            for (var i = 0; i < values.Length; i++)
+            {
+                if (values[i] != RDataFrame.NaInteger)
+                    result[i] = values[i] != 0;
+            }
+            return result;
+        }
+
+        #region Convert back
+
+        /// <summary>
+        /// Converts a <see cref="RDataFrame"/> into a data.frame with compact row names.
+        /// The numeric, integer and logical columns are allocated by the native host then copied at once.
+        /// </summary>
+        public static SymbolicExpression ToSexp(REngine engine, RDataFrame frame)
+        {
+            var columns = new SymbolicExpression[frame.ColumnCount];
+            for (var i = 0; i < columns.Length; i++)
+                columns[i] = ToColumn(engine, frame[i]);
+
+            var sexp = new GenericVector(engine, columns);
+            sexp.SetNames(frame.Names.ToArray());
+            sexp.SetAttribute("row.names", engine.CreateIntegerVector(frame.RowCount == 0
+                ? new int[0]
+                : new[] { RDataFrame.NaInteger, -frame.RowCount }));
+            sexp.SetAttribute("class", engine.CreateCharacterVector(new[] { "data.frame" }));
+            return sexp;
+        }
+
+        private static SymbolicExpression ToColumn(REngine engine, Array column)
+        {
+            switch (column)
+            {
+                case double[] values:
+                    return Alloc(engine, REALSXP, values);
+                case int[] values:
+                    return Alloc(engine, INTSXP, values);
+                case bool[] values:
+                    return Alloc(engine, LGLSXP, values.Select(p => p ? 1 : 0).ToArray());
+                case bool?[] values:
+                    return Alloc(engine, LGLSXP, values.Select(p => p.HasValue ? (p.Value ? 1 : 0) : RDataFrame.NaInteger).ToArray());
+                case string[] values:
+                    return StringCache.ToSexp(engine, values);
+                case DateTime[] values:
+                    return Alloc(engine, REALSXP, values.ToTicks(out var tzone)).AddPosixctAttributes(tzone);
+                case DateTime?[] values:
+                    return Alloc(engine, REALSXP, ToTicks(values, out tzone)).AddPosixctAttributes(tzone);
+                default:
+                    throw new NotSupportedException($"Unsupported data.frame column type: {column.GetType().Name}");
+            }
+        }
+
+        private static double[] ToTicks(DateTime?[] values, out string[] tzone)
+        {
+            var first = values.FirstOrDefault(p => p.HasValue);
+            tzone = first.HasValue && first.Value.Kind == DateTimeKind.Utc
+                ? ResourcesLoader.UtcOlsonTimezone
+                : ResourcesLoader.LocalOlsonTimezone;
+
+            var result = new double[values.Length];
+            for (var i = 0; i < values.Length; i++)
+            {
+                result[i] = values[i].HasValue
+                    ? values[i].Value.ToTicks()
+                    : RDataFrame.NaReal;
+            }
+            return result;
+        }
+
+        private static SymbolicExpression Alloc<T>(REngine engine, int type, T[] values) where T : unmanaged
+        {
+            var sexp = NativeCallbacks.AllocVector(type, values.Length, out var data);
+            values.AsSpan().CopyTo(new Span<T>((void*)data, values.Length));
+            return engine.CreateFromNativeSexp(sexp);
+        }
+
+        #endregion
+    }
+}
@@ -1,5 +1,4 @@
 ﻿using System;
-using System.Runtime.InteropServices;
 using RDotNet;
 
 namespace Sharper.Converters.RDotNet
@@ -23,9 +22,9 @@ namespace Sharper.Converters.RDotNet
 
         public object Convert(Type type)
         {
-            var pointer = _sexp.Engine.GetFunction<R_ExternalPtrAddr>()(_sexp.DangerousGetHandle());
+            var handle = _sexp.Engine.GetFunction<R_ExternalPtrAddr>()(_sexp.DangerousGetHandle());
 
-            return Marshal.GetObjectForIUnknown(pointer);
+            return ObjectTable.Get(handle);
         }
 
         #endregion
@@ -36,8 +35,8 @@ namespace Sharper.Converters.RDotNet
 
         public static void Release(REngine engine, IntPtr pointer)
         {
-            var objPtr = engine.GetFunction<R_ExternalPtrAddr>()(pointer);
-            Marshal.Release(objPtr);
+            var handle = engine.GetFunction<R_ExternalPtrAddr>()(pointer);
+            ObjectTable.Release(handle);
         }
 
         #endregion
@@ -48,7 +47,7 @@ namespace Sharper.Converters.RDotNet
 
             var tag = engine.CreateCharacterVector(new[] { NET_OBJ_TAG, instance.GetType().FullName });
             var ptr = engine.GetFunction<R_MakeExternalPtr>()(
-                Marshal.GetIUnknownForObject(instance),
+                ObjectTable.Add(instance),
                 tag.DangerousGetHandle(),
                 engine.NilValue.DangerousGetHandle());
             
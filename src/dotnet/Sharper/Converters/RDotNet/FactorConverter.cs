@@ -0,0 +1,133 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Linq;
+using System.Reflection;
+using RDotNet;
+
+namespace Sharper.Converters.RDotNet
+{
+    /// <summary>
+    /// Converts a factor into a <see cref="RFactor"/>, its labels, or an enum whose names are its levels.
+    /// The labels are decoded once per level, so a value shares its string instance with all the values of its level.
+    /// The other types are delegated to a <see cref="VectorConverter{T}"/>, so a factor still binds its R codes,
+    /// which are preferred to the labels when both overloads exist.
+    /// </summary>
+    public unsafe class FactorConverter : IConverter
+    {
+        private const int INTSXP = 13;
+
+        private static readonly Type[] labelsTypes = { typeof(string[]), typeof(List<string>), typeof(IList<string>), typeof(ICollection<string>), typeof(IEnumerable<string>) };
+        private static readonly MethodInfo enumsToSexpMethod = typeof(FactorConverter).GetMethod(nameof(EnumsToSexp), BindingFlags.NonPublic | BindingFlags.Static);
+        private static readonly ConcurrentDictionary<Type, Func<REngine, Array, SymbolicExpression>> enumsToSexp = new ConcurrentDictionary<Type, Func<REngine, Array, SymbolicExpression>>();
+
+        private readonly IntegerVector _sexp;
+        private readonly VectorConverter<int> _codes;
+        private readonly Type[] _types;
+        private RFactor _factor;
+
+        public FactorConverter(IntegerVector sexp)
+        {
+            _sexp = sexp;
+            _codes = new VectorConverter<int>(sexp);
+            _types = new[] { typeof(RFactor) }
+                .Concat(_codes.GetClrTypes())
+                .Concat(sexp.Length <= 1 ? new[] { typeof(string) } : Type.EmptyTypes)
+                .Concat(labelsTypes)
+                .ToArray();
+        }
+
+        #region Implementation of IConverter
+
+        public Type[] GetClrTypes() => _types;
+
+        public object Convert(Type type)
+        {
+            if (type == typeof(RFactor))
+                return Factor;
+            if (type == typeof(string))
+                return Factor.Length > 0 ? Factor[0] : null;
+            if (type == typeof(string[]))
+                return Factor.ToArray();
+            if (type == typeof(List<string>) || type == typeof(IList<string>) || type == typeof(ICollection<string>) || type == typeof(IEnumerable<string>))
+                return Factor.ToArray().ToList();
+            // An empty factor has no value to read, it gives the default one
+            if (type.IsEnum)
+                return Factor.Length > 0 ? Factor.ToEnums(type).GetValue(0) : Activator.CreateInstance(type);
+            if (type.IsEnumArray())
+                return Factor.ToEnums(type.GetElementType());
+
+            return _codes.Convert(type);
+        }
+
+        #endregion
+
+        private RFactor Factor => _factor ?? (_factor = ToFactor());
+
+        private RFactor ToFactor()
+        {
+            var levels = _sexp.GetAttribute("levels");
+            var labels = levels == null ? new string[0] : StringCache.Read(levels.AsCharacter());
+
+            // The R codes start at 1
+            var codes = _sexp.ToArray();
+            for (var i = 0; i < codes.Length; i++)
+                codes[i] = codes[i] == RDataFrame.NaInteger ? RFactor.NaCode : codes[i] - 1;
+
+            return new RFactor(codes, labels);
+        }
+
+        #region Convert back
+
+        /// <summary>
+        /// Converts a <see cref="RFactor"/> into a factor, its codes are allocated by the native host.
+        /// </summary>
+        public static SymbolicExpression ToSexp(REngine engine, RFactor factor)
+        {
+            var sexp = NativeCallbacks.AllocVector(INTSXP, factor.Length, out var data);
+            var codes = new Span<int>((void*)data, factor.Length);
+            for (var i = 0; i < codes.Length; i++)
+                codes[i] = factor.Codes[i] == RFactor.NaCode ? RDataFrame.NaInteger : factor.Codes[i] + 1;
+
+            var result = engine.CreateFromNativeSexp(sexp);
+            result.SetAttribute("levels", StringCache.ToSexp(engine, factor.Levels));
+            result.SetAttribute("class", engine.CreateCharacterVector(new[] { "factor" }));
+            return result;
+        }
+
+        /// <summary>
+        /// Converts an enum array into a factor, whose levels are the enum names.
+        /// A value which isn't defined by the enum is NA.
+        /// </summary>
+        public static SymbolicExpression ToSexp(REngine engine, Array values)
+        {
+            var toSexp = enumsToSexp.GetOrAdd(values.GetType().GetElementType(), p => (Func<REngine, Array, SymbolicExpression>)enumsToSexpMethod
+                .MakeGenericMethod(p)
+                .CreateDelegate(typeof(Func<REngine, Array, SymbolicExpression>)));
+            return toSexp(engine, values);
+        }
+
+        private static SymbolicExpression EnumsToSexp<TEnum>(REngine engine, Array array) where TEnum : struct
+        {
+            var values = (TEnum[])array;
+            var names = Enum.GetNames(typeof(TEnum));
+            var levels = (TEnum[])Enum.GetValues(typeof(TEnum));
+
+            // An alias keeps the code of the first name
+            var codes = new Dictionary<TEnum, int>(levels.Length);
+            for (var i = 0; i < levels.Length; i++)
+            {
+                if (!codes.ContainsKey(levels[i]))
+                    codes.Add(levels[i], i);
+            }
+
+            var factor = new int[values.Length];
+            for (var i = 0; i < values.Length; i++)
+                factor[i] = codes.TryGetValue(values[i], out var code) ? code : RFactor.NaCode;
+
+            return ToSexp(engine, new RFactor(factor, names));
+        }
+
+        #endregion
+    }
+}
@@ -1,5 +1,6 @@
 ﻿using System;
 using System.Collections.Generic;
+using Apache.Arrow;
 using RDotNet;
 using RDotNet.Internals;
 using Sharper.Loggers;
@@ -8,6 +9,9 @@ namespace Sharper.Converters.RDotNet
 {
     public class RDotNetConverter : IDataConverter
     {
+        private const int INTSXP = 13;
+        private const int REALSXP = 14;
+
         private static readonly REngine engine = REngine.GetInstance(initialize: false);
 
         static RDotNetConverter()
@@ -34,9 +38,10 @@ namespace Sharper.Converters.RDotNet
             => _convertersBack.ContainsKey(type);
 
         public IConverter GetConverter(long pointer)
-        {
-            var sexp = engine.CreateFromNativeSexp(new IntPtr(pointer));
+            => GetConverter(engine.CreateFromNativeSexp(new IntPtr(pointer)));
 
+        private IConverter GetConverter(SymbolicExpression sexp)
+        {
             _logger.DebugFormat("SEXP type: {0}", sexp.Type);
 
             if (_converters.TryGetValue(sexp.Type, out var factory))
@@ -45,6 +50,40 @@ namespace Sharper.Converters.RDotNet
             throw new InvalidCastException($"Unable to find a converter from R type: {sexp.Type}");
         }
 
+        public IConverter GetConverter(long pointer, long dataPointer, long length)
+        {
+            // A data.frame is given with its columns table, a data pointer and length pair per column
+            if (length < 0 && dataPointer != 0)
+                return new DataFrameConverter(engine.CreateFromNativeSexp(new IntPtr(pointer)).AsList(), this, new IntPtr(dataPointer), (int)-length);
+
+            var sexp = engine.CreateFromNativeSexp(new IntPtr(pointer));
+            var converter = GetConverter(sexp);
+            if (dataPointer == 0) return converter;
+
+            // Only the plain vectors and matrices, the date time, time span and factor keep their own conversion
+            var type = converter.GetType();
+            if (type == typeof(VectorConverter<double>))
+                return new RVectorConverter<double>(converter, new RVector<double>(new IntPtr(pointer), new IntPtr(dataPointer), (int)length, true));
+            // R stores the logical values as integers
+            if (type == typeof(VectorConverter<int>) || type == typeof(VectorConverter<bool>))
+                return new RVectorConverter<int>(converter, new RVector<int>(new IntPtr(pointer), new IntPtr(dataPointer), (int)length, true));
+            if (type == typeof(MatrixConverter<double>))
+                return new RMatrixConverter<double>(converter, ToRMatrix<double>(sexp, dataPointer));
+            if (type == typeof(MatrixConverter<int>) || type == typeof(MatrixConverter<bool>))
+                return new RMatrixConverter<int>(converter, ToRMatrix<int>(sexp, dataPointer));
+            // The CHARSXP pointers are read at once instead of one by one
+            if (type == typeof(CharacterVectorConverter))
+                return new CharacterVectorConverter(sexp.AsCharacter(), new IntPtr(dataPointer));
+
+            return converter;
+        }
+
+        private static RMatrix<T> ToRMatrix<T>(SymbolicExpression sexp, long dataPointer) where T : unmanaged
+        {
+            var dim = sexp.GetAttribute("dim").AsInteger();
+            return new RMatrix<T>(sexp.DangerousGetHandle(), new IntPtr(dataPointer), dim[0], dim[1], true);
+        }
+
         public long ConvertBack(Type type, object data)
         {
             var sexp = ConvertToSexp(type, data);
@@ -71,6 +110,8 @@ namespace Sharper.Converters.RDotNet
 
             if (data.GetType().IsEnum)
                 return ConvertToSexp(typeof(string), data.ToString());
+            if (data.GetType().IsEnumArray())
+                return FactorConverter.ToSexp(engine, (Array)data);
 
             // Try to convert a generic list or dictionary first
             if (ListConverter.TryConvertBack(engine, this, data, out var result))
@@ -89,8 +130,12 @@ namespace Sharper.Converters.RDotNet
             SetupRToDotNetConverter(SymbolicExpressionType.IntegerVector, ConvertFromIntegerVector);
             SetupRToDotNetConverter(SymbolicExpressionType.NumericVector, ConvertFromNumericalVector);
             SetupRToDotNetConverter(SymbolicExpressionType.LogicalVector, ConvertFromLogicalVector);
-            SetupRToDotNetConverter(SymbolicExpressionType.ExternalPointer, p => new ExternalPtrConverter(p));
-            SetupRToDotNetConverter(SymbolicExpressionType.List, p => new ListConverter(p.AsList(), this));
+            SetupRToDotNetConverter(SymbolicExpressionType.ExternalPointer, p => ArrowBatchConverter.IsArrowBatch(p)
+                ? (IConverter)new ArrowBatchConverter(p)
+                : new ExternalPtrConverter(p));
+            SetupRToDotNetConverter(SymbolicExpressionType.List, p => p.IsDataFrame()
+                ? (IConverter)new DataFrameConverter(p.AsList(), this)
+                : new ListConverter(p.AsList(), this));
         }
 
         public void SetupRToDotNetConverter(SymbolicExpressionType type, Func<SymbolicExpression, IConverter> factory)
@@ -122,7 +167,7 @@ namespace Sharper.Converters.RDotNet
         {
             return sexp.IsMatrix()
                 ? (IConverter)new MatrixConverter<string>(sexp.AsCharacterMatrix())
-                : new VectorConverter<string>(sexp.AsCharacter());
+                : new CharacterVectorConverter(sexp.AsCharacter());
         }
 
         private static IConverter ConvertFromIntegerVector(SymbolicExpression sexp)
@@ -137,6 +182,8 @@ namespace Sharper.Converters.RDotNet
 
             if (sexp.IsDiffTime())
                 return new IntegerDiffTimeVectorConverter(sexp.AsInteger());
+            if (sexp.IsFactor())
+                return new FactorConverter(sexp.AsInteger());
 
             return new VectorConverter<int>(sexp.AsInteger());
         }
@@ -180,11 +227,11 @@ namespace Sharper.Converters.RDotNet
             SetupDotNetToRConverter(typeof(void), p => null);
 
             SetupDotNetToRConverter(typeof(string), p => engine.CreateCharacter((string)p));
-            SetupDotNetToRConverter(typeof(string[]), p => engine.CreateCharacterVector((string[])p));
-            SetupDotNetToRConverter(typeof(List<string>), p => engine.CreateCharacterVector((IEnumerable<string>)p));
-            SetupDotNetToRConverter(typeof(IList<string>), p => engine.CreateCharacterVector((IEnumerable<string>)p));
-            SetupDotNetToRConverter(typeof(ICollection<string>), p => engine.CreateCharacterVector((IEnumerable<string>)p));
-            SetupDotNetToRConverter(typeof(IEnumerable<string>), p => engine.CreateCharacterVector((IEnumerable<string>)p));
+            SetupDotNetToRConverter(typeof(string[]), p => StringCache.ToSexp(engine, (string[])p));
+            SetupDotNetToRConverter(typeof(List<string>), p => StringCache.ToSexp(engine, (IEnumerable<string>)p));
+            SetupDotNetToRConverter(typeof(IList<string>), p => StringCache.ToSexp(engine, (IEnumerable<string>)p));
+            SetupDotNetToRConverter(typeof(ICollection<string>), p => StringCache.ToSexp(engine, (IEnumerable<string>)p));
+            SetupDotNetToRConverter(typeof(IEnumerable<string>), p => StringCache.ToSexp(engine, (IEnumerable<string>)p));
             SetupDotNetToRConverter(typeof(string[,]), p => engine.CreateCharacterMatrix((string[,])p));
 
             SetupDotNetToRConverter(typeof(int), p => engine.CreateInteger((int)p));
@@ -193,7 +240,7 @@ namespace Sharper.Converters.RDotNet
             SetupDotNetToRConverter(typeof(IList<int>), p => engine.CreateIntegerVector((IEnumerable<int>)p));
             SetupDotNetToRConverter(typeof(ICollection<int>), p => engine.CreateIntegerVector((IEnumerable<int>)p));
             SetupDotNetToRConverter(typeof(IEnumerable<int>), p => engine.CreateIntegerVector((IEnumerable<int>)p));
-            SetupDotNetToRConverter(typeof(int[,]), p => engine.CreateIntegerMatrix((int[,])p));
+            SetupDotNetToRConverter(typeof(int[,]), p => engine.CreateMatrix((int[,])p));
 
             SetupDotNetToRConverter(typeof(bool), p => engine.CreateLogical((bool)p));
             SetupDotNetToRConverter(typeof(bool[]), p => engine.CreateLogicalVector((bool[])p));
@@ -209,7 +256,7 @@ namespace Sharper.Converters.RDotNet
             SetupDotNetToRConverter(typeof(IList<double>), p => engine.CreateNumericVector((IEnumerable<double>)p));
             SetupDotNetToRConverter(typeof(ICollection<double>), p => engine.CreateNumericVector((IEnumerable<double>)p));
             SetupDotNetToRConverter(typeof(IEnumerable<double>), p => engine.CreateNumericVector((IEnumerable<double>)p));
-            SetupDotNetToRConverter(typeof(double[,]), p => engine.CreateNumericMatrix((double[,])p));
+            SetupDotNetToRConverter(typeof(double[,]), p => engine.CreateMatrix((double[,])p));
 
             SetupDotNetToRConverter(typeof(DateTime), p => engine.CreatePosixct((DateTime)p));
             SetupDotNetToRConverter(typeof(DateTime[]), p => engine.CreatePosixctVector((DateTime[])p));
@@ -226,6 +273,44 @@ namespace Sharper.Converters.RDotNet
             SetupDotNetToRConverter(typeof(ICollection<TimeSpan>), p => engine.CreateDiffTimeVector((IEnumerable<TimeSpan>)p));
             SetupDotNetToRConverter(typeof(IEnumerable<TimeSpan>), p => engine.CreateDiffTimeVector((IEnumerable<TimeSpan>)p));
             SetupDotNetToRConverter(typeof(TimeSpan[,]), p => engine.CreateDiffTimeMatrix((TimeSpan[,])p));
+
+            SetupDotNetToRConverter(typeof(RFactor), p => FactorConverter.ToSexp(engine, (RFactor)p));
+            SetupDotNetToRConverter(typeof(RDataFrame), p => DataFrameConverter.ToSexp(engine, (RDataFrame)p));
+            SetupDotNetToRConverter(typeof(RecordBatch), p => ArrowBatchConverter.ToSexp(engine, (RecordBatch)p));
+
+            SetupDotNetToRConverter(typeof(RVector<double>), p => ConvertRVector((RVector<double>)p, v => engine.CreateNumericVector(v.ToArray())));
+            SetupDotNetToRConverter(typeof(RVector<int>), p => ConvertRVector((RVector<int>)p, v => engine.CreateIntegerVector(v.ToArray())));
+
+            SetupDotNetToRConverter(typeof(RMatrix<double>), p => ConvertRMatrix((RMatrix<double>)p, REALSXP));
+            SetupDotNetToRConverter(typeof(RMatrix<int>), p => ConvertRMatrix((RMatrix<int>)p, INTSXP));
+        }
+
+        private static SymbolicExpression ConvertRVector<T>(RVector<T> vector, Func<RVector<T>, SymbolicExpression> copy) where T : unmanaged
+        {
+            // A view bound to an R vector returns it as is, otherwise the data are copied
+            return vector.Sexp != IntPtr.Zero
+                ? engine.CreateFromNativeSexp(vector.Sexp)
+                : copy(vector);
+        }
+
+        private static unsafe SymbolicExpression ConvertRMatrix<T>(RMatrix<T> matrix, int type) where T : unmanaged
+        {
+            SymbolicExpression sexp;
+            if (matrix.Sexp != IntPtr.Zero)
+            {
+                // A view bound to an R matrix returns it as is, a matrix allocated by RAllocator gets its dimensions
+                sexp = engine.CreateFromNativeSexp(matrix.Sexp);
+                if (sexp.IsMatrix()) return sexp;
+            }
+            else
+            {
+                // Otherwise the data are copied, they already have the R layout
+                var pointer = NativeCallbacks.AllocVector(type, matrix.Length, out var data);
+                matrix.AsReadOnlySpan().CopyTo(new Span<T>((void*)data, matrix.Length));
+                sexp = engine.CreateFromNativeSexp(pointer);
+            }
+
+            return sexp.AddDimAttribute(matrix.RowCount, matrix.ColumnCount);
         }
 
         public void SetupDotNetToRConverter(Type type, Func<object, SymbolicExpression> converter)
@@ -0,0 +1,180 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+using RDotNet;
+
+namespace Sharper.Converters.RDotNet
+{
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    internal delegate IntPtr STRING_ELT(IntPtr x, IntPtr i);
+
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    internal delegate void SET_STRING_ELT(IntPtr x, IntPtr i, IntPtr v);
+
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    internal delegate IntPtr Rf_translateCharUTF8(IntPtr x);
+
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    internal unsafe delegate IntPtr Rf_mkCharLenCE(byte* name, int length, int encoding);
+
+    /// <summary>
+    /// Interns the strings exchanged with R, so a repeated value is decoded or encoded once instead of once per element.
+    /// R already interns its strings into CHARSXP, so the same value is the same pointer, which keys the R -> .Net direction.
+    /// The .Net string keys the .Net -> R direction.
+    /// </summary>
+    /// <remarks>
+    /// The cached CHARSXP are held by a preserved character vector, so R can't collect then reuse them while they are cached.
+    /// Once full, the oldest entries are evicted first.
+    /// It uses the R API, so it can only be used from the R thread.
+    /// </remarks>
+    internal static unsafe class StringCache
+    {
+        public const int Capacity = 1 << 16;
+
+        private const int CE_UTF8 = 1;
+
+        private static readonly Dictionary<IntPtr, int> slotsByCharsxp = new Dictionary<IntPtr, int>(Capacity);
+        private static readonly Dictionary<string, int> slotsByString = new Dictionary<string, int>(Capacity, StringComparer.Ordinal);
+        private static readonly IntPtr[] charsxps = new IntPtr[Capacity];
+        private static readonly string[] strings = new string[Capacity];
+        private static int next;
+        private static int count;
+
+        private static CharacterVector pool;
+        private static IntPtr naString;
+        private static STRING_ELT stringElt;
+        private static SET_STRING_ELT setStringElt;
+        private static Rf_translateCharUTF8 translateCharUtf8;
+        private static Rf_mkCharLenCE mkCharLenCe;
+
+        /// <summary>
+        /// Reads the strings of a character vector, one by one.
+        /// </summary>
+        public static string[] Read(CharacterVector sexp)
+        {
+            Initialize(sexp.Engine);
+
+            var handle = sexp.DangerousGetHandle();
+            var result = new string[sexp.Length];
+            for (var i = 0; i < result.Length; i++)
+                result[i] = GetString(stringElt(handle, new IntPtr(i)));
+            return result;
+        }
+
+        /// <summary>
+        /// Reads the strings of a character vector from its CHARSXP pointers.
+        /// </summary>
+        public static string[] Read(REngine engine, IntPtr elements, int length)
+        {
+            Initialize(engine);
+
+            var charsxp = (IntPtr*)elements;
+            var result = new string[length];
+            for (var i = 0; i < length; i++)
+                result[i] = GetString(charsxp[i]);
+            return result;
+        }
+
+        /// <summary>
+        /// Creates a character vector, a null value is NA.
+        /// </summary>
+        public static CharacterVector ToSexp(REngine engine, IReadOnlyList<string> values)
+        {
+            Initialize(engine);
+
+            // Each CHARSXP is set into the vector before the next allocation, so an evicted one stays referenced
+            var sexp = new CharacterVector(engine, values.Count);
+            var handle = sexp.DangerousGetHandle();
+            string previous = null;
+            var charsxp = naString;
+            for (var i = 0; i < values.Count; i++)
+            {
+                var value = values[i];
+                if (!ReferenceEquals(value, previous))
+                {
+                    charsxp = GetCharsxp(value);
+                    previous = value;
+                }
+                setStringElt(handle, new IntPtr(i), charsxp);
+            }
+            return sexp;
+        }
+
+        public static CharacterVector ToSexp(REngine engine, IEnumerable<string> values)
+            => ToSexp(engine, values as IReadOnlyList<string> ?? new List<string>(values));
+
+        private static string GetString(IntPtr charsxp)
+        {
+            if (charsxp == naString) return null;
+
+            if (slotsByCharsxp.TryGetValue(charsxp, out var slot))
+                return strings[slot];
+
+            var chars = (byte*)translateCharUtf8(charsxp);
+            var length = 0;
+            while (chars[length] != 0) length++;
+
+            var value = Encoding.UTF8.GetString(chars, length);
+            Add(charsxp, value);
+            return value;
+        }
+
+        private static IntPtr GetCharsxp(string value)
+        {
+            if (value == null) return naString;
+
+            if (slotsByString.TryGetValue(value, out var slot))
+                return charsxps[slot];
+
+            // R raises an error on an embedded nul, which can't jump over the managed frames
+            if (value.IndexOf('\0') >= 0)
+                throw new ArgumentException("An R string can't contain an embedded nul");
+
+            var bytes = Encoding.UTF8.GetBytes(value);
+            IntPtr charsxp;
+            fixed (byte* p = bytes)
+                charsxp = mkCharLenCe(p, bytes.Length, CE_UTF8);
+
+            Add(charsxp, value);
+            return charsxp;
+        }
+
+        private static void Add(IntPtr charsxp, string value)
+        {
+            var slot = next;
+            next = (next + 1) % Capacity;
+
+            if (count == Capacity)
+            {
+                // A value can have several CHARSXP, one per encoding, so only the keys of this slot are removed
+                if (slotsByCharsxp.TryGetValue(charsxps[slot], out var evicted) && evicted == slot)
+                    slotsByCharsxp.Remove(charsxps[slot]);
+                if (slotsByString.TryGetValue(strings[slot], out evicted) && evicted == slot)
+                    slotsByString.Remove(strings[slot]);
+            }
+            else count++;
+
+            setStringElt(pool.DangerousGetHandle(), new IntPtr(slot), charsxp);
+            charsxps[slot] = charsxp;
+            strings[slot] = value;
+            slotsByCharsxp[charsxp] = slot;
+            if (!slotsByString.ContainsKey(value))
+                slotsByString.Add(value, slot);
+        }
+
+        private static void Initialize(REngine engine)
+        {
+            if (pool != null) return;
+
+            naString = engine.GetPredefinedSymbol("R_NaString").DangerousGetHandle();
+            stringElt = engine.GetFunction<STRING_ELT>();
+            setStringElt = engine.GetFunction<SET_STRING_ELT>();
+            translateCharUtf8 = engine.GetFunction<Rf_translateCharUTF8>();
+            mkCharLenCe = engine.GetFunction<Rf_mkCharLenCE>();
+
+            // Preserved as long as its wrapper lives
+            pool = new CharacterVector(engine, Capacity);
+        }
+    }
+}
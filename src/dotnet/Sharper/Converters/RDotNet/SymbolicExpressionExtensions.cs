@@ -18,6 +18,9 @@ namespace Sharper.Converters.RDotNet
 
     public static class SymbolicExpressionExtensions
     {
+        private const int INTSXP = 13;
+        private const int REALSXP = 14;
+
         public static SymbolicExpression ToExternalPointer(this REngine engine, object instance) 
             => ExternalPtrConverter.ToExternalPointer(engine, instance);
 
@@ -56,31 +59,74 @@ namespace Sharper.Converters.RDotNet
             return new IntegerVector(engine, vector);
         }
 
-        #endregion
+        /// <summary>
+        /// Creates a new numeric matrix, the values are transposed by blocks into an R vector allocated by the native host.
+        /// </summary>
+        /// <param name="engine">The engine.</param>
+        /// <param name="matrix">The values.</param>
+        /// <returns>The new matrix.</returns>
+        public static SymbolicExpression CreateMatrix(this REngine engine, double[,] matrix)
+            => NativeCallbacks.IsRegistered ? CreateMatrix(engine, REALSXP, matrix) : engine.CreateNumericMatrix(matrix);
 
-        #region DateTime
+        /// <summary>
+        /// Creates a new integer matrix, the values are transposed by blocks into an R vector allocated by the native host.
+        /// </summary>
+        /// <param name="engine">The engine.</param>
+        /// <param name="matrix">The values.</param>
+        /// <returns>The new matrix.</returns>
+        public static SymbolicExpression CreateMatrix(this REngine engine, int[,] matrix)
+            => NativeCallbacks.IsRegistered ? CreateMatrix(engine, INTSXP, matrix) : engine.CreateIntegerMatrix(matrix);
 
-        public static bool IsPosixct(this SymbolicExpression sexp)
+        private static SymbolicExpression CreateMatrix<T>(REngine engine, int type, T[,] matrix) where T : unmanaged
         {
-            return sexp.GetAttributeNames().Any(p => string.Equals("class", p))
-                && sexp.GetAttribute("class").AsCharacter().ToArray().Any(p => string.Equals("POSIXct", p));
+            var rowCount = matrix.GetLength(0);
+            var columnCount = matrix.GetLength(1);
+            var sexp = NativeCallbacks.AllocVector(type, (long)rowCount * columnCount, out var data);
+            new RMatrix<T>(sexp, data, rowCount, columnCount).CopyFrom(matrix);
+
+            return engine.CreateFromNativeSexp(sexp).AddDimAttribute(rowCount, columnCount);
         }
 
-        public static bool IsPosixlt(this SymbolicExpression sexp)
+        public static SymbolicExpression AddDimAttribute(this SymbolicExpression sexp, int rowCount, int columnCount)
         {
-            return sexp.GetAttributeNames().Any(p => string.Equals("class", p))
-                && sexp.GetAttribute("class").AsCharacter().ToArray().Any(p => string.Equals("POSIXlt", p));
+            sexp.SetAttribute("dim", sexp.Engine.CreateIntegerVector(new[] { rowCount, columnCount }));
+            return sexp;
         }
 
-        public static TimeZoneInfo GetWindowsTimezone(this SymbolicExpression sexp)
+        /// <summary>
+        /// Tests a class without listing the attribute names first, a missing attribute is null.
+        /// </summary>
+        private static bool HasClass(this SymbolicExpression sexp, string name)
         {
-            if (sexp.GetAttributeNames().Any(p => string.Equals("tzone", p)))
+            var classes = sexp.GetAttribute("class")?.AsCharacter();
+            if (classes == null) return false;
+
+            for (var i = 0; i < classes.Length; i++)
             {
-                var tzone = sexp.GetAttribute("tzone").AsCharacter().ToArray().FirstOrDefault();
-                return tzone.GetWindowsTimezone();
+                if (string.Equals(name, classes[i]))
+                    return true;
             }
+            return false;
+        }
+
+        #endregion
+
+        #region DateTime
+
+        public static bool IsPosixct(this SymbolicExpression sexp) => sexp.HasClass("POSIXct");
 
-            return TimeZoneInfo.Local;
+        public static bool IsPosixlt(this SymbolicExpression sexp) => sexp.HasClass("POSIXlt");
+
+        /// <summary>
+        /// Gets the timezone of the tzone attribute, the local timezone if it's missing or unknown.
+        /// The timezone is resolved once per name, see <see cref="ResourcesLoader.GetWindowsTimezone(string)"/>.
+        /// </summary>
+        public static TimeZoneInfo GetWindowsTimezone(this SymbolicExpression sexp)
+        {
+            var tzone = sexp.GetAttribute("tzone")?.AsCharacter();
+            return tzone != null && tzone.Length > 0
+                ? tzone[0].GetWindowsTimezone()
+                : TimeZoneInfo.Local;
         }
 
         public static SymbolicExpression CreatePosixct(this REngine engine, DateTime value)
@@ -105,7 +151,7 @@ namespace Sharper.Converters.RDotNet
         public static SymbolicExpression CreatePosixctMatrix(this REngine engine, DateTime[,] data)
         {
             var numeric = data.ToTicks(out var tzone);
-            var sexp = engine.CreateNumericMatrix(numeric);
+            var sexp = engine.CreateMatrix(numeric);
             return sexp.AddPosixctAttributes(tzone);
         }
 
@@ -120,11 +166,7 @@ namespace Sharper.Converters.RDotNet
 
         #region TimeSpan
 
-        public static bool IsDiffTime(this SymbolicExpression sexp)
-        {
-            return sexp.GetAttributeNames().Any(p => string.Equals("class", p))
-                && sexp.GetAttribute("class").AsCharacter().ToArray().Any(p => string.Equals("difftime", p));
-        }
+        public static bool IsDiffTime(this SymbolicExpression sexp) => sexp.HasClass("difftime");
 
         private const string SECS = "secs";
         private const string MINS = "mins";
@@ -134,9 +176,7 @@ namespace Sharper.Converters.RDotNet
 
         public static string GetUnits(this SymbolicExpression sexp)
         {
-            string units = null;
-            if (sexp.GetAttributeNames().Any(p => string.Equals("units", p)))
-                units = sexp.GetAttribute("units").AsCharacter().FirstOrDefault();
+            var units = sexp.GetAttribute("units")?.AsCharacter().FirstOrDefault();
 
             switch (units)
             {
@@ -175,7 +215,7 @@ namespace Sharper.Converters.RDotNet
         public static SymbolicExpression CreateDiffTimeMatrix(this REngine engine, TimeSpan[,] data)
         {
             var numeric = data.FromTimeSpan();
-            var sexp = engine.CreateNumericMatrix(numeric);
+            var sexp = engine.CreateMatrix(numeric);
             return sexp.AddDiffTimeAttributes();
         }
 
@@ -29,7 +29,7 @@ namespace Sharper.Converters.RDotNet
         public object Convert(Type type)
         {
             if (type == typeof(TOut))
-                return ConvertToSingle(_vector.ToArray()[0]);
+                return ConvertToSingle(_vector[0]);
             if (type == typeof(TOut[]) || type == typeof(Array) || type == typeof(IEnumerable))
                 return ConvertToArray(_vector.ToArray());
             if (type == typeof(List<TOut>) || type == typeof(IList<TOut>) || type == typeof(ICollection<TOut>) || type == typeof(IEnumerable<TOut>))
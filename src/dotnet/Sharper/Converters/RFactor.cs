@@ -0,0 +1,128 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Reflection;
+
+namespace Sharper.Converters
+{
+    /// <summary>
+    /// Dictionary encoded view of an R factor: a code per value, which indexes its label in the levels.
+    /// A factor argument is converted without decoding a string per value, and a returned one is converted back
+    /// into a factor, so a column with few distinct values crosses as integers.
+    /// </summary>
+    /// <remarks>
+    /// The codes start at 0 as .Net indexes, where R starts its own at 1. NA is <see cref="NaCode"/>.
+    /// </remarks>
+    public class RFactor
+    {
+        /// <summary>
+        /// The code of a NA value.
+        /// </summary>
+        public const int NaCode = -1;
+
+        private static readonly MethodInfo toEnumsMethod = typeof(RFactor).GetMethod(nameof(ToEnums), Type.EmptyTypes);
+        private static readonly ConcurrentDictionary<Type, Func<RFactor, Array>> toEnums = new ConcurrentDictionary<Type, Func<RFactor, Array>>();
+
+        /// <exception cref="ArgumentOutOfRangeException">A code isn't NA and doesn't index a level.</exception>
+        public RFactor(int[] codes, string[] levels)
+        {
+            Codes = codes ?? throw new ArgumentNullException(nameof(codes));
+            Levels = levels ?? throw new ArgumentNullException(nameof(levels));
+
+            for (var i = 0; i < codes.Length; i++)
+            {
+                if (codes[i] < NaCode || codes[i] >= levels.Length)
+                    throw new ArgumentOutOfRangeException(nameof(codes), $"The code {codes[i]} at {i} doesn't index any of the {levels.Length} levels");
+            }
+        }
+
+        public int[] Codes { get; }
+
+        public string[] Levels { get; }
+
+        public int Length => Codes.Length;
+
+        /// <summary>
+        /// Gets the label of a value, null for NA.
+        /// </summary>
+        public string this[int index] => Codes[index] == NaCode ? null : Levels[Codes[index]];
+
+        /// <summary>
+        /// Decodes the labels, a label is the same string instance for all its values.
+        /// </summary>
+        public string[] ToArray()
+        {
+            var result = new string[Codes.Length];
+            for (var i = 0; i < result.Length; i++)
+                result[i] = this[i];
+            return result;
+        }
+
+        /// <summary>
+        /// Decodes the values as an enum, whose names are the levels. Each level is parsed once.
+        /// </summary>
+        /// <exception cref="ArgumentException">A level isn't a name of the enum.</exception>
+        /// <exception cref="InvalidCastException">A value is NA.</exception>
+        public TEnum[] ToEnums<TEnum>() where TEnum : struct
+        {
+            var levels = new TEnum[Levels.Length];
+            for (var i = 0; i < levels.Length; i++)
+                levels[i] = (TEnum)Enum.Parse(typeof(TEnum), Levels[i]);
+
+            var result = new TEnum[Codes.Length];
+            for (var i = 0; i < result.Length; i++)
+            {
+                var code = Codes[i];
+                if (code == NaCode)
+                    throw new InvalidCastException($"The value at {i} is NA, which isn't a {typeof(TEnum).Name}");
+                result[i] = levels[code];
+            }
+            return result;
+        }
+
+        /// <summary>
+        /// Decodes the values as an enum given by its type.
+        /// </summary>
+        public Array ToEnums(Type enumType)
+        {
+            if (!enumType.IsEnum)
+                throw new ArgumentException($"Not an enum type: {enumType}", nameof(enumType));
+
+            var toEnum = toEnums.GetOrAdd(enumType, p => (Func<RFactor, Array>)toEnumsMethod
+                .MakeGenericMethod(p)
+                .CreateDelegate(typeof(Func<,>).MakeGenericType(typeof(RFactor), p.MakeArrayType())));
+            return toEnum(this);
+        }
+
+        /// <summary>
+        /// Encodes the values, the levels are the distinct values in their order of appearance.
+        /// </summary>
+        public static RFactor Encode(IReadOnlyList<string> values)
+        {
+            var codes = new int[values.Count];
+            var levels = new List<string>();
+            var indexes = new Dictionary<string, int>(StringComparer.Ordinal);
+            for (var i = 0; i < codes.Length; i++)
+            {
+                var value = values[i];
+                if (value == null)
+                {
+                    codes[i] = NaCode;
+                    continue;
+                }
+
+                if (!indexes.TryGetValue(value, out var code))
+                {
+                    code = levels.Count;
+                    indexes.Add(value, code);
+                    levels.Add(value);
+                }
+                codes[i] = code;
+            }
+
+            return new RFactor(codes, levels.ToArray());
+        }
+
+        public override string ToString() => $"RFactor[{Length}, {Levels.Length} levels]";
+    }
+}
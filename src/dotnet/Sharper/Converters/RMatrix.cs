@@ -0,0 +1,150 @@
+﻿using System;
+using System.Runtime.CompilerServices;
+
+namespace Sharper.Converters
+{
+    /// <summary>
+    /// View on the memory of an R numeric, integer or logical matrix, without any copy.
+    /// R stores a matrix by column, so a column is contiguous and can be viewed as a span.
+    /// A view is only valid during the .Net call which received it,
+    /// because the R matrix can be collected as soon as the call returns.
+    /// </summary>
+    /// <remarks>
+    /// A view on an R argument is read-only, because the R matrix can be shared by other R variables.
+    /// </remarks>
+    /// <typeparam name="T"><see cref="double"/> for a numeric matrix, <see cref="int"/> for an integer or logical matrix.</typeparam>
+    public readonly unsafe struct RMatrix<T> where T : unmanaged
+    {
+        public RMatrix(IntPtr data, int rowCount, int columnCount)
+            : this(IntPtr.Zero, data, rowCount, columnCount) { }
+
+        public RMatrix(IntPtr sexp, IntPtr data, int rowCount, int columnCount)
+            : this(sexp, data, rowCount, columnCount, false) { }
+
+        public RMatrix(IntPtr sexp, IntPtr data, int rowCount, int columnCount, bool isReadOnly)
+        {
+            if (rowCount < 0)
+                throw new ArgumentOutOfRangeException(nameof(rowCount));
+            if (columnCount < 0)
+                throw new ArgumentOutOfRangeException(nameof(columnCount));
+            if ((long)rowCount * columnCount > int.MaxValue)
+                throw new ArgumentOutOfRangeException(nameof(columnCount), $"Too large for a span: {rowCount} x {columnCount}");
+
+            Sexp = sexp;
+            Data = data;
+            RowCount = rowCount;
+            ColumnCount = columnCount;
+            IsReadOnly = isReadOnly;
+        }
+
+        /// <summary>
+        /// Gets the R vector SEXP pointer, <see cref="IntPtr.Zero"/> if the view isn't bound to an R vector.
+        /// Returning a bound view from .Net returns this R vector without any copy.
+        /// </summary>
+        public IntPtr Sexp { get; }
+
+        /// <summary>
+        /// Gets the pointer on the first element of the first column.
+        /// </summary>
+        public IntPtr Data { get; }
+
+        public int RowCount { get; }
+
+        public int ColumnCount { get; }
+
+        public int Length => RowCount * ColumnCount;
+
+        /// <summary>
+        /// Gets if the view can't write into the R matrix, which is the case of an R argument.
+        /// </summary>
+        public bool IsReadOnly { get; }
+
+        public T this[int row, int column]
+        {
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            get
+            {
+                if ((uint)row >= (uint)RowCount || (uint)column >= (uint)ColumnCount)
+                    throw new IndexOutOfRangeException();
+                return ((T*)Data)[(long)column * RowCount + row];
+            }
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            set
+            {
+                if ((uint)row >= (uint)RowCount || (uint)column >= (uint)ColumnCount)
+                    throw new IndexOutOfRangeException();
+                if (IsReadOnly)
+                    throw ReadOnlyException();
+                ((T*)Data)[(long)column * RowCount + row] = value;
+            }
+        }
+
+        /// <summary>
+        /// Gets a column, which is contiguous in the R memory.
+        /// </summary>
+        public Span<T> Column(int column)
+        {
+            if (IsReadOnly)
+                throw ReadOnlyException();
+            if ((uint)column >= (uint)ColumnCount)
+                throw new ArgumentOutOfRangeException(nameof(column));
+            return new Span<T>((T*)Data + (long)column * RowCount, RowCount);
+        }
+
+        /// <summary>
+        /// Gets a column to read, which is contiguous in the R memory.
+        /// </summary>
+        public ReadOnlySpan<T> ReadOnlyColumn(int column)
+        {
+            if ((uint)column >= (uint)ColumnCount)
+                throw new ArgumentOutOfRangeException(nameof(column));
+            return new ReadOnlySpan<T>((T*)Data + (long)column * RowCount, RowCount);
+        }
+
+        /// <summary>
+        /// Gets all the elements column after column, as R stores them.
+        /// </summary>
+        public Span<T> AsSpan()
+        {
+            if (IsReadOnly)
+                throw ReadOnlyException();
+            return new Span<T>((void*)Data, Length);
+        }
+
+        public ReadOnlySpan<T> AsReadOnlySpan() => new ReadOnlySpan<T>((void*)Data, Length);
+
+        /// <summary>
+        /// Copies the matrix into a .Net array, whose elements are stored row after row.
+        /// </summary>
+        public T[,] ToArray()
+        {
+            var result = new T[RowCount, ColumnCount];
+            if (result.Length == 0) return result;
+
+            // The column-major matrix is its transpose read row-major
+            fixed (T* destination = &result[0, 0])
+                MatrixTranspose.Transpose((T*)Data, ColumnCount, RowCount, destination);
+            return result;
+        }
+
+        /// <summary>
+        /// Copies a .Net array into the matrix, which must have the same dimensions.
+        /// </summary>
+        public void CopyFrom(T[,] matrix)
+        {
+            if (IsReadOnly)
+                throw ReadOnlyException();
+            if (matrix.GetLength(0) != RowCount || matrix.GetLength(1) != ColumnCount)
+                throw new ArgumentException($"Expected a {RowCount} x {ColumnCount} matrix, got {matrix.GetLength(0)} x {matrix.GetLength(1)}", nameof(matrix));
+            if (matrix.Length == 0) return;
+
+            fixed (T* source = &matrix[0, 0])
+                MatrixTranspose.Transpose(source, RowCount, ColumnCount, (T*)Data);
+        }
+
+        public override string ToString() => $"RMatrix<{typeof(T).Name}>[{RowCount} x {ColumnCount}]";
+
+        private static InvalidOperationException ReadOnlyException()
+            => new InvalidOperationException("The R matrix given in argument is read-only, allocate the result with RAllocator instead");
+    }
+}
@@ -0,0 +1,47 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Linq;
+
+namespace Sharper.Converters
+{
+    /// <summary>
+    /// Decorates a matrix converter to bind <see cref="RMatrix{T}"/> arguments directly on the R memory,
+    /// and to copy a .Net array from the R memory by a blocked transpose. Other types are delegated to the decorated converter.
+    /// </summary>
+    /// <remarks>
+    /// A <see cref="RMatrix{T}"/> argument is read-only, because the R matrix can be shared by other R variables.
+    /// </remarks>
+    public class RMatrixConverter<T> : IConverter where T : unmanaged
+    {
+        private static readonly Type[] viewTypes = { typeof(RMatrix<T>) };
+        private static readonly ConcurrentDictionary<Type[], Type[]> typesCache = new ConcurrentDictionary<Type[], Type[]>();
+
+        private readonly IConverter _converter;
+        private readonly RMatrix<T> _matrix;
+        private readonly Type[] _types;
+
+        public RMatrixConverter(IConverter converter, RMatrix<T> matrix)
+        {
+            _converter = converter;
+            _matrix = matrix;
+            // The decorated converters share static type arrays, so the result is cached by reference
+            _types = typesCache.GetOrAdd(converter.GetClrTypes(), p => p.Concat(viewTypes).ToArray());
+        }
+
+        #region Implementation of IConverter
+
+        public Type[] GetClrTypes() => _types;
+
+        public object Convert(Type type)
+        {
+            if (type == typeof(RMatrix<T>))
+                return _matrix;
+            if (type == typeof(T[,]))
+                return _matrix.ToArray();
+
+            return _converter.Convert(type);
+        }
+
+        #endregion
+    }
+}
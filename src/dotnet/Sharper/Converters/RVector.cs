@@ -0,0 +1,100 @@
+﻿using System;
+using System.Runtime.CompilerServices;
+
+namespace Sharper.Converters
+{
+    /// <summary>
+    /// View on the memory of an R numeric, integer or logical vector, without any copy.
+    /// A view is only valid during the .Net call which received it, 
+    /// because the R vector can be collected as soon as the call returns.
+    /// </summary>
+    /// <remarks>
+    /// A view on an R argument is read-only, because the R vector can be shared by other R variables.
+    /// </remarks>
+    /// <typeparam name="T"><see cref="double"/> for a numeric vector, <see cref="int"/> for an integer or logical vector.</typeparam>
+    public readonly unsafe struct RVector<T> where T : unmanaged
+    {
+        public RVector(IntPtr data, int length)
+            : this(IntPtr.Zero, data, length) { }
+
+        public RVector(IntPtr sexp, IntPtr data, int length)
+            : this(sexp, data, length, false) { }
+
+        public RVector(IntPtr sexp, IntPtr data, int length, bool isReadOnly)
+        {
+            if (length < 0)
+                throw new ArgumentOutOfRangeException(nameof(length));
+
+            Sexp = sexp;
+            Data = data;
+            Length = length;
+            IsReadOnly = isReadOnly;
+        }
+
+        /// <summary>
+        /// Gets the R vector SEXP pointer, <see cref="IntPtr.Zero"/> if the view isn't bound to an R vector.
+        /// Returning a bound view from .Net returns this R vector without any copy.
+        /// </summary>
+        public IntPtr Sexp { get; }
+
+        /// <summary>
+        /// Gets the pointer on the first element of the R vector.
+        /// </summary>
+        public IntPtr Data { get; }
+
+        /// <summary>
+        /// Gets the number of elements.
+        /// </summary>
+        public int Length { get; }
+
+        /// <summary>
+        /// Gets if the view can't write into the R vector, which is the case of an R argument.
+        /// </summary>
+        public bool IsReadOnly { get; }
+
+        public T this[int index]
+        {
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            get
+            {
+                if ((uint)index >= (uint)Length)
+                    throw new IndexOutOfRangeException();
+                return ((T*)Data)[index];
+            }
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            set
+            {
+                if ((uint)index >= (uint)Length)
+                    throw new IndexOutOfRangeException();
+                if (IsReadOnly)
+                    throw ReadOnlyException();
+                ((T*)Data)[index] = value;
+            }
+        }
+
+        public Span<T> AsSpan()
+        {
+            if (IsReadOnly)
+                throw ReadOnlyException();
+            return new Span<T>((void*)Data, Length);
+        }
+
+        public ReadOnlySpan<T> AsReadOnlySpan() => new ReadOnlySpan<T>((void*)Data, Length);
+
+        public Memory<T> AsMemory()
+        {
+            if (IsReadOnly)
+                throw ReadOnlyException();
+            return new RVectorMemoryManager<T>(this).Memory;
+        }
+
+        public ReadOnlyMemory<T> AsReadOnlyMemory() => new RVectorMemoryManager<T>(this).Memory;
+
+        public T[] ToArray() => AsReadOnlySpan().ToArray();
+
+        public override string ToString() => $"RVector<{typeof(T).Name}>[{Length}]";
+
+        private static InvalidOperationException ReadOnlyException()
+            => new InvalidOperationException("The R vector given in argument is read-only, allocate the result with RAllocator instead");
+    }
+}
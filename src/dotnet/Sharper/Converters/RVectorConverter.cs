@@ -0,0 +1,55 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Linq;
+
+namespace Sharper.Converters
+{
+    /// <summary>
+    /// Decorates a vector converter to bind <see cref="RVector{T}"/>, <see cref="ReadOnlySpan{T}"/> and <see cref="ReadOnlyMemory{T}"/> 
+    /// arguments directly on the R memory. Other types are delegated to the decorated converter.
+    /// </summary>
+    /// <remarks>
+    /// The views are read-only, because R vectors have a value semantic: the vector given in argument 
+    /// can be shared by other R variables or be a constant of the R code.
+    /// </remarks>
+    public class RVectorConverter<T> : IConverter where T : unmanaged
+    {
+        private static readonly Type[] viewTypes = { typeof(RVector<T>), typeof(ReadOnlySpan<T>), typeof(ReadOnlyMemory<T>) };
+        private static readonly ConcurrentDictionary<Type[], Type[]> typesCache = new ConcurrentDictionary<Type[], Type[]>();
+
+        private readonly IConverter _converter;
+        private readonly RVector<T> _vector;
+        private readonly Type[] _types;
+
+        public RVectorConverter(IConverter converter, RVector<T> vector)
+        {
+            _converter = converter;
+            _vector = vector;
+            // The decorated converters share static type arrays, so the result is cached by reference
+            _types = typesCache.GetOrAdd(converter.GetClrTypes(), p => p.Concat(viewTypes).ToArray());
+        }
+
+        #region Implementation of IConverter
+
+        public Type[] GetClrTypes() => _types;
+
+        public object Convert(Type type)
+        {
+            // Spans can't be boxed, the vector is given instead and the invoker binds it as span
+            if (type == typeof(RVector<T>) || type == typeof(ReadOnlySpan<T>))
+                return _vector;
+            if (type == typeof(ReadOnlyMemory<T>))
+                return _vector.AsReadOnlyMemory();
+
+            // Faster than the decorated converter because of a single copy
+            if (type == typeof(T))
+                return _vector[0];
+            if (type == typeof(T[]))
+                return _vector.ToArray();
+
+            return _converter.Convert(type);
+        }
+
+        #endregion
+    }
+}
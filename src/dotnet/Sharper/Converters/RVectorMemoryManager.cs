@@ -0,0 +1,34 @@
+﻿using System;
+using System.Buffers;
+
+namespace Sharper.Converters
+{
+    /// <summary>
+    /// Exposes an <see cref="RVector{T}"/> as <see cref="Memory{T}"/>.
+    /// The R memory isn't moved by the R garbage collector, so pinning is a no-op.
+    /// </summary>
+    public sealed unsafe class RVectorMemoryManager<T> : MemoryManager<T> where T : unmanaged
+    {
+        private readonly RVector<T> _vector;
+
+        public RVectorMemoryManager(RVector<T> vector)
+        {
+            _vector = vector;
+        }
+
+        // A read-only view is only exposed as ReadOnlyMemory, which can't write through this span
+        public override Span<T> GetSpan() => new Span<T>((void*)_vector.Data, _vector.Length);
+
+        public override MemoryHandle Pin(int elementIndex = 0)
+        {
+            if ((uint)elementIndex > (uint)_vector.Length)
+                throw new ArgumentOutOfRangeException(nameof(elementIndex));
+
+            return new MemoryHandle((T*)_vector.Data + elementIndex);
+        }
+
+        public override void Unpin() { }
+
+        protected override void Dispose(bool disposing) { }
+    }
+}
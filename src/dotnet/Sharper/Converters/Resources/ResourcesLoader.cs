@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.IO;
 using System.Linq;
@@ -103,15 +104,47 @@ namespace Sharper.Converters.Resources
                 => $"Other: {Other}, Territory: {Territory}, Type: {Type}";
         }
 
+        /// <summary>
+        /// Gets the timezone of an R tz name, the local timezone if it's empty or unknown.
+        /// A name is resolved once then memoised, and a timezone equivalent to UTC resolves to <see cref="TimeZoneInfo.Utc"/>,
+        /// so the conversions can skip the per element offsets by a reference test.
+        /// </summary>
         public static TimeZoneInfo GetWindowsTimezone(this string tzone)
         {
             if (string.IsNullOrEmpty(tzone))
                 return TimeZoneInfo.Local;
 
-            if (olsonToWindows.TryGetValue(tzone, out var timezone))
-                return timezone;
+            return resolvedTimezones.GetOrAdd(tzone, ResolveTimezone);
+        }
+
+        private static readonly ConcurrentDictionary<string, TimeZoneInfo> resolvedTimezones = new ConcurrentDictionary<string, TimeZoneInfo>(StringComparer.Ordinal);
+        private static readonly HashSet<string> utcAliases = new HashSet<string>(StringComparer.OrdinalIgnoreCase)
+        {
+            "UTC", "UCT", "GMT", "GMT0", "Zulu", "Universal", "Greenwich",
+            "Etc/UTC", "Etc/UCT", "Etc/GMT", "Etc/GMT0", "Etc/GMT+0", "Etc/GMT-0", "Etc/Zulu", "Etc/Universal", "Etc/Greenwich"
+        };
+
+        private static TimeZoneInfo ResolveTimezone(string tzone)
+        {
+            if (utcAliases.Contains(tzone))
+                return TimeZoneInfo.Utc;
+
+            if (!olsonToWindows.TryGetValue(tzone, out var timezone))
+            {
+                try
+                {
+                    // The system knows the Windows ids, and the Olson ones out of Windows
+                    timezone = TimeZoneInfo.FindSystemTimeZoneById(tzone);
+                }
+                catch (Exception e) when (e is TimeZoneNotFoundException || e is InvalidTimeZoneException)
+                {
+                    return TimeZoneInfo.Local;
+                }
+            }
 
-            return TimeZoneInfo.Local;
+            return timezone.BaseUtcOffset == TimeSpan.Zero && timezone.GetAdjustmentRules().Length == 0
+                ? TimeZoneInfo.Utc
+                : timezone;
         }
 
         public static string GetOlsonTimezone(this TimeZoneInfo timezone)
@@ -129,72 +162,115 @@ namespace Sharper.Converters.Resources
         public static readonly string[] UtcOlsonTimezone;
         public static readonly string[] LocalOlsonTimezone;
 
+        private const double TICKS_PER_SECOND = 1e7;
+
+        /// <summary>
+        /// Converts seconds since the R origin into a date time of the given timezone.
+        /// </summary>
         [MethodImpl(MethodImplOptions.AggressiveInlining)]
         public static DateTime FromTicks(this double ticks, TimeZoneInfo timezone)
-            => TimeZoneInfo.ConvertTime(new DateTime(OriginTicks + (long)(ticks * 1e7)), timezone);
+        {
+            var utc = new DateTime(OriginTicks + (long)(ticks * TICKS_PER_SECOND), DateTimeKind.Utc);
+            return ReferenceEquals(timezone, TimeZoneInfo.Utc)
+                ? utc
+                : TimeZoneInfo.ConvertTime(utc, timezone);
+        }
+
+        /// <summary>
+        /// Converts seconds since the R origin into date times of the given timezone.
+        /// The timezone is tested once, so a UTC vector is converted by arithmetic only.
+        /// </summary>
+        public static void FromTicks(this ReadOnlySpan<double> ticks, Span<DateTime> result, TimeZoneInfo timezone)
+        {
+            if (result.Length < ticks.Length)
+                throw new ArgumentException($"Expected at least {ticks.Length} elements, got {result.Length}", nameof(result));
+
+            if (ReferenceEquals(timezone, TimeZoneInfo.Utc))
+            {
+                for (var i = 0; i < ticks.Length; i++)
+                    result[i] = new DateTime(OriginTicks + (long)(ticks[i] * TICKS_PER_SECOND), DateTimeKind.Utc);
+                return;
+            }
+
+            for (var i = 0; i < ticks.Length; i++)
+                result[i] = TimeZoneInfo.ConvertTime(new DateTime(OriginTicks + (long)(ticks[i] * TICKS_PER_SECOND), DateTimeKind.Utc), timezone);
+        }
 
         public static DateTime[] FromTicks(this double[] ticks, TimeZoneInfo timezone)
         {
             var result = new DateTime[ticks.Length];
-            for (var i = 0; i < ticks.Length; i++)
-                result[i] = FromTicks(ticks[i], timezone);
-            
+            FromTicks(ticks, result, timezone);
             return result;
         }
 
-        public static DateTime[,] FromTicks(this double[,] ticks, TimeZoneInfo timezone)
+        public static unsafe DateTime[,] FromTicks(this double[,] ticks, TimeZoneInfo timezone)
         {
-            var nRow = ticks.GetLength(0);
-            var nCol = ticks.GetLength(1);
+            var result = new DateTime[ticks.GetLength(0), ticks.GetLength(1)];
+            if (result.Length == 0) return result;
 
-            var result = new DateTime[nRow, nCol];
-            for (var i = 0; i < nRow; i++)
-            {
-                for (var j = 0; j < nCol; j++)
-                    result[i, j] = FromTicks(ticks[i, j], timezone);
-            }
+            // Both matrices are stored row after row, so they are converted as flat vectors
+            fixed (double* source = &ticks[0, 0])
+            fixed (DateTime* destination = &result[0, 0])
+                FromTicks(new ReadOnlySpan<double>(source, ticks.Length), new Span<DateTime>(destination, result.Length), timezone);
             return result;
         }
 
+        /// <summary>
+        /// Converts a date time into seconds since the R origin.
+        /// </summary>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static double ToTicks(this DateTime dateTime)
+        {
+            var ticks = dateTime.Kind == DateTimeKind.Utc
+                ? dateTime.Ticks
+                : dateTime.ToUniversalTime().Ticks;
+            return (ticks - OriginTicks) / TICKS_PER_SECOND;
+        }
+
         public static double ToTicks(this DateTime dateTime, out string[] tzone)
         {
             tzone = dateTime.Kind == DateTimeKind.Utc
                 ? UtcOlsonTimezone
                 : LocalOlsonTimezone;
-            return (dateTime.ToUniversalTime() - Origin).TotalSeconds;
+            return dateTime.ToTicks();
         }
 
-        public static double[] ToTicks(this DateTime[] array, out string[] tzone)
+        /// <summary>
+        /// Converts date times into seconds since the R origin, the UTC ones by arithmetic only.
+        /// The timezone is given by the first date time.
+        /// </summary>
+        public static void ToTicks(this ReadOnlySpan<DateTime> dateTimes, Span<double> result, out string[] tzone)
         {
-            var length = array.Length;
-            var result = new double[length];
+            if (result.Length < dateTimes.Length)
+                throw new ArgumentException($"Expected at least {dateTimes.Length} elements, got {result.Length}", nameof(result));
 
-            tzone = length > 0 && array[0].Kind == DateTimeKind.Utc
+            tzone = dateTimes.Length > 0 && dateTimes[0].Kind == DateTimeKind.Utc
                 ? UtcOlsonTimezone
                 : LocalOlsonTimezone;
 
-            for (var i = 0; i < length; i++)
-                result[i] = (array[i].ToUniversalTime() - Origin).TotalSeconds;
+            for (var i = 0; i < dateTimes.Length; i++)
+                result[i] = dateTimes[i].ToTicks();
+        }
 
+        public static double[] ToTicks(this DateTime[] array, out string[] tzone)
+        {
+            var result = new double[array.Length];
+            ToTicks(array, result, out tzone);
             return result;
         }
 
-        public static double[,] ToTicks(this DateTime[,] matrix, out string[] tzone)
+        public static unsafe double[,] ToTicks(this DateTime[,] matrix, out string[] tzone)
         {
-            var nRow = matrix.GetLength(0);
-            var nCol = matrix.GetLength(1);
-            var result = new double[nRow, nCol];
-
-            tzone = nRow > 0 && nCol > 0 && matrix[0, 0].Kind == DateTimeKind.Utc
-                ? UtcOlsonTimezone
-                : LocalOlsonTimezone;
-
-            for (var i = 0; i < nRow; i++)
+            var result = new double[matrix.GetLength(0), matrix.GetLength(1)];
+            if (result.Length == 0)
             {
-                for (var j = 0; j < nCol; j++)
-                    result[i, j] = (matrix[i, j] - Origin).TotalSeconds;
+                tzone = LocalOlsonTimezone;
+                return result;
             }
 
+            fixed (DateTime* source = &matrix[0, 0])
+            fixed (double* destination = &result[0, 0])
+                ToTicks(new ReadOnlySpan<DateTime>(source, matrix.Length), new Span<double>(destination, result.Length), out tzone);
             return result;
         }
 
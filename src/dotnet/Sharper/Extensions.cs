@@ -3,6 +3,7 @@ using System.Collections.Generic;
 using System.Linq;
 using System.Reflection;
 using System.Text;
+using System.Threading.Tasks;
 using Sharper.Converters;
 
 namespace Sharper
@@ -34,55 +35,124 @@ namespace Sharper
                 return false;
             }
 
+            // Syntax: 'Namespace.Type'
+            if (TypeIndex.TryGetType(typeName, out type))
+                return true;
+
+            var split = typeName.Split(',');
+            if (split.Length > 1 && TypeIndex.TryGetType(split[0].Trim(), split[1].Trim(), out type))
+                return true;
+
+            // Generic or fully qualified syntax, which aren't indexed
             type = Type.GetType(typeName);
             if (type != null)
                 return true;
 
-            var assemblies = AppDomain.CurrentDomain.GetAssemblies();
-            var split = typeName.Split(',');
             if (split.Length > 1)
             {
                 // Syntax: 'Namespace.Type, Assembly'
-
                 var assemblyName = split[1].Trim();
-                var assembly = assemblies.FirstOrDefault(p => string.Equals(p.GetName().Name, assemblyName));
-                if (assembly == null)
+                if (!TypeIndex.TryGetAssembly(assemblyName, out _))
                 {
                     errorMsg = $"Assembly not found {assemblyName}";
                     return false;
                 }
-
-                type = assembly.GetType(split[0].Trim());
-                if (type != null)
-                    return true;
             }
 
-            // Syntax: 'Namespace.Type'
             typeName = split[0].Trim();
-            var length = assemblies.Length;
-            for (var i = 0; i < length; i++)
+            if (TypeIndex.TryGetType(typeName, out type))
+                return true;
+
+            errorMsg = $"Type {typeName} not found.";
+            return false;
+        }
+
+        private static readonly Dictionary<string, Type> typeAliases = new Dictionary<string, Type>
+        {
+            { "bool", typeof(bool) },
+            { "byte", typeof(byte) },
+            { "sbyte", typeof(sbyte) },
+            { "char", typeof(char) },
+            { "short", typeof(short) },
+            { "ushort", typeof(ushort) },
+            { "int", typeof(int) },
+            { "uint", typeof(uint) },
+            { "long", typeof(long) },
+            { "ulong", typeof(ulong) },
+            { "float", typeof(float) },
+            { "double", typeof(double) },
+            { "decimal", typeof(decimal) },
+            { "string", typeof(string) },
+            { "object", typeof(object) },
+        };
+
+        public static bool TryGetParameterType(this string typeName, out Type type, out string errorMsg)
+        {
+            errorMsg = null;
+            type = null;
+            if (string.IsNullOrEmpty(typeName))
             {
-                var types = assemblies[i].GetTypes();
-                var l = types.Length;
-                for (var j = 0; j < l; j++)
-                {
-                    if (!string.Equals(types[j].FullName, typeName))
-                        continue;
+                errorMsg = "Missing parameter type name because of null or empty";
+                return false;
+            }
 
-                    type = types[j];
-                    return true;
-                }
+            typeName = typeName.Trim();
+
+            // Syntax: 'Type[]' or 'Type[,]'
+            if (typeName.EndsWith("[]") || typeName.EndsWith("[,]"))
+            {
+                var isMatrix = typeName.EndsWith("[,]");
+                if (!typeName.Substring(0, typeName.Length - (isMatrix ? 3 : 2)).TryGetParameterType(out var elementType, out errorMsg))
+                    return false;
+
+                type = isMatrix ? elementType.MakeArrayType(2) : elementType.MakeArrayType();
+                return true;
             }
 
-            errorMsg = $"Type {typeName} not found.";
-            return false;
+            if (typeAliases.TryGetValue(typeName, out type))
+                return true;
+
+            return typeName.TryGetType(out type, out errorMsg);
         }
 
+        /// <summary>
+        /// Gets the name of a parameter type, as parsed back by <see cref="TryGetParameterType"/>.
+        /// Returns null if the type can't be named this way, i.e. a generic type.
+        /// </summary>
+        public static string GetParameterTypeName(this Type type)
+        {
+            type = type.Extract();
+
+            string name;
+            if (type.IsArray && type.GetArrayRank() <= 2)
+            {
+                name = type.GetElementType().GetParameterTypeName();
+                if (name != null)
+                    name += type.GetArrayRank() == 1 ? "[]" : "[,]";
+            }
+            else
+                name = typeAliases.FirstOrDefault(p => p.Value == type).Key ?? type.FullName;
+
+            return name != null && name.TryGetParameterType(out var parsed, out _) && parsed == type
+                ? name : null;
+        }
+
+        /// <summary>
+        /// Gets a type, its interfaces and its base types, from the closest to the farthest, ending by <see cref="object"/>.
+        /// The hierarchy is computed once per type, so the result is shared and mustn't be modified.
+        /// </summary>
         public static Type[] GetFullHierarchy(this Type type)
         {
             if (type == null)
                 return defaultTypeArray;
 
+            return ResolutionCache.GetFullHierarchy(type, computeFullHierarchy);
+        }
+
+        private static readonly Func<Type, Type[]> computeFullHierarchy = ComputeFullHierarchy;
+
+        private static Type[] ComputeFullHierarchy(Type type)
+        {
             var priorities = new Dictionary<Type, int>();
             var queue = new Queue<Type>();
             queue.Enqueue(type);
@@ -220,13 +290,54 @@ namespace Sharper
         public static bool TryGetMethod(this Type type,
             string methodName, BindingFlags flags, IConverter[] converters,
             out MethodInfo method)
+        {
+            method = ResolutionCache.GetOverload(type, methodName, flags, converters, resolveMethod) as MethodInfo;
+            return method != null;
+        }
+
+        private static readonly Func<Type, string, BindingFlags, IConverter[], MethodBase> resolveMethod = ResolveMethod;
+
+        private static MethodBase ResolveMethod(Type type, string methodName, BindingFlags flags, IConverter[] converters)
         {
             var methods = type.GetMethods(flags)
                 .Where(p => string.Equals(methodName, p.Name))
                 .OfType<MethodBase>()
                 .ToArray();
 
-            method = methods.GetMethod(converters) as MethodInfo;
+            return methods.GetMethod(converters);
+        }
+
+        public static bool TryGetMethod(this Type type,
+            string methodName, BindingFlags flags, Type[] parameterTypes,
+            out MethodInfo method, out string errorMsg)
+        {
+            errorMsg = null;
+            var methods = type.GetMethods(flags)
+                .Where(p => string.Equals(methodName, p.Name))
+                .ToArray();
+
+            if (methods.Length == 0)
+            {
+                method = null;
+                errorMsg = $"Method not found, Type: {type.FullName}, Method: {methodName}";
+                return false;
+            }
+
+            // Without parameter types the method name has to be enough
+            if (parameterTypes == null)
+            {
+                method = methods.Length == 1 ? methods[0] : null;
+                if (method == null)
+                    errorMsg = $"Ambiguous method {methodName} for Type: {type.FullName}, specify the argument types among: {string.Join(", ", methods.Select(p => $"({string.Join(", ", p.GetParameters().Select(x => x.ParameterType.Extract().FullName))})"))}";
+                return method != null;
+            }
+
+            method = methods.FirstOrDefault(p => p.GetParameters()
+                .Select(x => x.ParameterType.Extract())
+                .SequenceEqual(parameterTypes));
+
+            if (method == null)
+                errorMsg = $"Method not found, Type: {type.FullName}, Method: {methodName}({string.Join(", ", parameterTypes.Select(p => p.FullName))})";
             return method != null;
         }
 
@@ -234,14 +345,21 @@ namespace Sharper
             IConverter[] converters,
             out ConstructorInfo ctor)
         {
-            var constructors = type.GetConstructors(BindingFlags.Public | BindingFlags.Instance)
+            ctor = ResolutionCache.GetOverload(type, ConstructorInfo.ConstructorName, BindingFlags.Public | BindingFlags.Instance, converters, resolveConstructor) as ConstructorInfo;
+            return ctor != null;
+        }
+
+        private static readonly Func<Type, string, BindingFlags, IConverter[], MethodBase> resolveConstructor = ResolveConstructor;
+
+        private static MethodBase ResolveConstructor(Type type, string name, BindingFlags flags, IConverter[] converters)
+        {
+            var constructors = type.GetConstructors(flags)
                 .OfType<MethodBase>()
                 .ToArray();
             if (constructors.Length == 0)
                 constructors = new MethodBase[] { type.GetConstructor(Type.EmptyTypes) };
 
-            ctor = constructors.GetMethod(converters) as ConstructorInfo;
-            return ctor != null;
+            return constructors.GetMethod(converters);
         }
 
         private static MethodBase GetMethod(this MethodBase[] methods, IConverter[] converters)
@@ -315,19 +433,18 @@ namespace Sharper
 
         public static object[] Call(this MethodInfo method, object instance, IConverter[] converters)
         {
+            var invoker = MethodInvoker.Get(method);
+            var parameterTypes = invoker.ParameterTypes;
             var length = converters.Length;
             var args = new object[length];
-            var parameters = method.GetParameters();
 
-            var hasByRef = false;
             for (var i = 0; i < length; i++)
-            {
-                hasByRef |= parameters[i].ParameterType.IsByRef;
-                args[i] = converters[i].Convert(parameters[i].ParameterType.Extract());
-            }
+                args[i] = converters[i].Convert(parameterTypes[i]);
+            CallStatistics.Mark(CallPhase.Conversion);
 
-            var result = method.Invoke(instance, args);
-            if (hasByRef)
+            var result = invoker.Invoke(instance, args);
+            CallStatistics.Mark(CallPhase.Invocation);
+            if (invoker.HasByRef)
             {
                 // Todo: we can do better by naming the arguments and defined which one is by ref for R
                 var results = new object[1 + length];
@@ -342,14 +459,58 @@ namespace Sharper
 
         public static object Call(this ConstructorInfo ctor, IConverter[] converters)
         {
+            var invoker = MethodInvoker.Get(ctor);
+            var parameterTypes = invoker.ParameterTypes;
             var length = converters.Length;
             var args = new object[length];
-            var parameters = ctor.GetParameters();
 
             for (var i = 0; i < length; i++)
-                args[i] = converters[i].Convert(parameters[i].ParameterType.Extract());
+                args[i] = converters[i].Convert(parameterTypes[i]);
+            CallStatistics.Mark(CallPhase.Conversion);
+
+            var result = invoker.Invoke(null, args);
+            CallStatistics.Mark(CallPhase.Invocation);
+            return result;
+        }
+
+        public static bool IsSpan(this Type type)
+        {
+            if (!type.IsGenericType) return false;
+
+            var definition = type.GetGenericTypeDefinition();
+            return definition == typeof(Span<>) || definition == typeof(ReadOnlySpan<>);
+        }
+
+        /// <summary>
+        /// Gets if the type views a vector or matrix memory, which is owned by R and only valid during the call.
+        /// </summary>
+        public static bool IsVectorView(this Type type)
+        {
+            if (type.IsSpan()) return true;
+            if (!type.IsGenericType) return false;
+
+            var definition = type.GetGenericTypeDefinition();
+            return definition == typeof(Memory<>) || definition == typeof(ReadOnlyMemory<>) || definition == typeof(RVector<>) || definition == typeof(RMatrix<>);
+        }
+
+        /// <summary>
+        /// Gets if the type is a Task or a ValueTask, with the type of its result or void.
+        /// The ValueTask types are matched by name because they aren't part of netstandard2.0.
+        /// </summary>
+        public static bool IsTask(this Type type, out Type resultType)
+        {
+            resultType = typeof(void);
+            if (type == typeof(Task) || type.FullName == "System.Threading.Tasks.ValueTask")
+                return true;
+
+            if (!type.IsGenericType) return false;
+
+            var definition = type.GetGenericTypeDefinition();
+            if (definition != typeof(Task<>) && definition.FullName != "System.Threading.Tasks.ValueTask`1")
+                return false;
 
-            return ctor.Invoke(args);
+            resultType = type.GetGenericArguments()[0];
+            return true;
         }
 
         public static bool IsEnumArray(this Type type)
@@ -5,7 +5,7 @@ namespace Sharper.Loggers
 {
     public abstract class AbstractLogger : ILogger
     {
-        private readonly StringBuilder _buffer = new StringBuilder();
+        [ThreadStatic] private static StringBuilder _buffer;
         private LogLevel _level;
 
         protected AbstractLogger(string name)
@@ -41,19 +41,40 @@ namespace Sharper.Loggers
         {
             if (!IsDebugEnabled) return;
 
-            _buffer.Clear();
-            _buffer.AppendFormat(format, args);
-            Debug(_buffer.ToString());
+            var buffer = GetBuffer();
+            buffer.AppendFormat(format, args);
+            Debug(buffer.ToString());
+        }
+
+        public void DebugFormat<T1>(string format, T1 arg1)
+        {
+            if (!IsDebugEnabled) return;
+
+            DebugOverride(string.Format(format, arg1));
+        }
+
+        public void DebugFormat<T1, T2>(string format, T1 arg1, T2 arg2)
+        {
+            if (!IsDebugEnabled) return;
+
+            DebugOverride(string.Format(format, arg1, arg2));
+        }
+
+        public void DebugFormat<T1, T2, T3>(string format, T1 arg1, T2 arg2, T3 arg3)
+        {
+            if (!IsDebugEnabled) return;
+
+            DebugOverride(string.Format(format, arg1, arg2, arg3));
         }
 
         public void Debug(string message, Exception e)
         {
             if (!IsDebugEnabled) return;
 
-            _buffer.Clear();
-            _buffer.AppendLine(message);
-            _buffer.AppendFormat(e);
-            Debug(_buffer.ToString());
+            var buffer = GetBuffer();
+            buffer.AppendLine(message);
+            buffer.AppendFormat(e);
+            Debug(buffer.ToString());
         }
 
         public bool IsInfoEnabled { get; private set; }
@@ -69,19 +90,40 @@ namespace Sharper.Loggers
         {
             if (!IsInfoEnabled) return;
 
-            _buffer.Clear();
-            _buffer.AppendFormat(format, args);
-            Info(_buffer.ToString());
+            var buffer = GetBuffer();
+            buffer.AppendFormat(format, args);
+            Info(buffer.ToString());
+        }
+
+        public void InfoFormat<T1>(string format, T1 arg1)
+        {
+            if (!IsInfoEnabled) return;
+
+            InfoOverride(string.Format(format, arg1));
+        }
+
+        public void InfoFormat<T1, T2>(string format, T1 arg1, T2 arg2)
+        {
+            if (!IsInfoEnabled) return;
+
+            InfoOverride(string.Format(format, arg1, arg2));
+        }
+
+        public void InfoFormat<T1, T2, T3>(string format, T1 arg1, T2 arg2, T3 arg3)
+        {
+            if (!IsInfoEnabled) return;
+
+            InfoOverride(string.Format(format, arg1, arg2, arg3));
         }
 
         public void Info(string message, Exception e)
         {
             if (!IsInfoEnabled) return;
 
-            _buffer.Clear();
-            _buffer.AppendLine(message);
-            _buffer.AppendFormat(e);
-            Info(_buffer.ToString());
+            var buffer = GetBuffer();
+            buffer.AppendLine(message);
+            buffer.AppendFormat(e);
+            Info(buffer.ToString());
         }
 
         public bool IsWarnEnabled { get; private set; }
@@ -97,19 +139,40 @@ namespace Sharper.Loggers
         {
             if (!IsWarnEnabled) return;
 
-            _buffer.Clear();
-            _buffer.AppendFormat(format, args);
-            Warn(_buffer.ToString());
+            var buffer = GetBuffer();
+            buffer.AppendFormat(format, args);
+            Warn(buffer.ToString());
+        }
+
+        public void WarnFormat<T1>(string format, T1 arg1)
+        {
+            if (!IsWarnEnabled) return;
+
+            WarnOverride(string.Format(format, arg1));
+        }
+
+        public void WarnFormat<T1, T2>(string format, T1 arg1, T2 arg2)
+        {
+            if (!IsWarnEnabled) return;
+
+            WarnOverride(string.Format(format, arg1, arg2));
+        }
+
+        public void WarnFormat<T1, T2, T3>(string format, T1 arg1, T2 arg2, T3 arg3)
+        {
+            if (!IsWarnEnabled) return;
+
+            WarnOverride(string.Format(format, arg1, arg2, arg3));
         }
 
         public void Warn(string message, Exception e)
         {
             if (!IsWarnEnabled) return;
 
-            _buffer.Clear();
-            _buffer.AppendLine(message);
-            _buffer.AppendFormat(e);
-            Warn(_buffer.ToString());
+            var buffer = GetBuffer();
+            buffer.AppendLine(message);
+            buffer.AppendFormat(e);
+            Warn(buffer.ToString());
         }
 
         public bool IsErrorEnabled { get; private set; }
@@ -125,19 +188,40 @@ namespace Sharper.Loggers
         {
             if (!IsErrorEnabled) return;
 
-            _buffer.Clear();
-            _buffer.AppendFormat(format, args);
-            Error(_buffer.ToString());
+            var buffer = GetBuffer();
+            buffer.AppendFormat(format, args);
+            Error(buffer.ToString());
+        }
+
+        public void ErrorFormat<T1>(string format, T1 arg1)
+        {
+            if (!IsErrorEnabled) return;
+
+            ErrorOverride(string.Format(format, arg1));
+        }
+
+        public void ErrorFormat<T1, T2>(string format, T1 arg1, T2 arg2)
+        {
+            if (!IsErrorEnabled) return;
+
+            ErrorOverride(string.Format(format, arg1, arg2));
+        }
+
+        public void ErrorFormat<T1, T2, T3>(string format, T1 arg1, T2 arg2, T3 arg3)
+        {
+            if (!IsErrorEnabled) return;
+
+            ErrorOverride(string.Format(format, arg1, arg2, arg3));
         }
 
         public void Error(string message, Exception e)
         {
             if (!IsErrorEnabled) return;
 
-            _buffer.Clear();
-            _buffer.AppendLine(message);
-            _buffer.AppendFormat(e);
-            Error(_buffer.ToString());
+            var buffer = GetBuffer();
+            buffer.AppendLine(message);
+            buffer.AppendFormat(e);
+            Error(buffer.ToString());
         }
 
         #endregion
@@ -147,6 +231,14 @@ namespace Sharper.Loggers
         protected abstract void WarnOverride(string message);
         protected abstract void ErrorOverride(string message);
 
+        private static StringBuilder GetBuffer()
+        {
+            // One buffer per thread, the loggers are shared by the R thread and the .Net threads
+            var buffer = _buffer ?? (_buffer = new StringBuilder());
+            buffer.Clear();
+            return buffer;
+        }
+
         private void UpdateLevel(LogLevel value)
         {
             _level = value;
@@ -0,0 +1,186 @@
+﻿using System;
+using System.Threading;
+
+namespace Sharper.Loggers
+{
+    /// <summary>
+    /// Logger which only queues the messages, a background thread writes them into the sink.
+    /// 
+    /// The queue is a bounded lock-free ring buffer of preallocated slots, each one owns a sequence number
+    /// telling the producers when it's free and the consumer when it's written.
+    /// When the buffer is full the messages are dropped rather than blocking the caller, the number of dropped
+    /// messages is written once the consumer catches up.
+    /// </summary>
+    public class AsyncLogger : AbstractLogger
+    {
+        private const int DefaultCapacity = 4096;
+        private const int FlushPeriodMs = 100;
+
+        private readonly ILogSink _sink;
+        private readonly Slot[] _slots;
+        private readonly long _mask;
+        private readonly AutoResetEvent _signal = new AutoResetEvent(false);
+        private readonly object _consumerLock = new object();
+        private long _enqueuePosition;
+        private long _dequeuePosition;
+        private long _dropped;
+        private long _reportedDropped;
+
+        /// <param name="name">The logger name.</param>
+        /// <param name="sink">Where the messages are written.</param>
+        /// <param name="capacity">The number of messages the buffer can hold, rounded up to a power of 2.</param>
+        public AsyncLogger(string name, ILogSink sink, int capacity = DefaultCapacity) : base(name)
+        {
+            if (capacity <= 0)
+                throw new ArgumentOutOfRangeException(nameof(capacity));
+
+            _sink = sink ?? throw new ArgumentNullException(nameof(sink));
+
+            var size = 1;
+            while (size < capacity) size <<= 1;
+            _slots = new Slot[size];
+            _mask = size - 1;
+            for (var i = 0; i < size; i++)
+                _slots[i].Sequence = i;
+
+            var thread = new Thread(Consume) { IsBackground = true, Name = $"{nameof(AsyncLogger)} {name}" };
+            thread.Start();
+
+            AppDomain.CurrentDomain.ProcessExit += (s, e) => Flush();
+        }
+
+        /// <summary>
+        /// Gets the number of messages dropped because the buffer was full.
+        /// </summary>
+        public long Dropped => Interlocked.Read(ref _dropped);
+
+        /// <summary>
+        /// Writes the queued messages into the sink and flushes it, from the calling thread.
+        /// </summary>
+        public void Flush()
+        {
+            lock (_consumerLock)
+            {
+                Drain();
+                _sink.Flush();
+            }
+        }
+
+        #region Overrides of AbstractLogger
+
+        protected override void DebugOverride(string message)
+            => Enqueue(LogLevel.Debug, message);
+
+        protected override void InfoOverride(string message)
+            => Enqueue(LogLevel.Info, message);
+
+        protected override void WarnOverride(string message)
+            => Enqueue(LogLevel.Warn, message);
+
+        protected override void ErrorOverride(string message)
+        {
+            Enqueue(LogLevel.Error, message);
+            // An error is written right away, the process may not survive it
+            _signal.Set();
+        }
+
+        #endregion
+
+        private void Enqueue(LogLevel level, string message)
+        {
+            var position = Volatile.Read(ref _enqueuePosition);
+            while (true)
+            {
+                var sequence = Volatile.Read(ref _slots[position & _mask].Sequence);
+                var diff = sequence - position;
+                if (diff == 0)
+                {
+                    // The slot is free, claim it
+                    if (Interlocked.CompareExchange(ref _enqueuePosition, position + 1, position) == position)
+                        break;
+                    position = Volatile.Read(ref _enqueuePosition);
+                }
+                else if (diff < 0)
+                {
+                    // The consumer hasn't released this slot yet, the buffer is full
+                    Interlocked.Increment(ref _dropped);
+                    return;
+                }
+                else position = Volatile.Read(ref _enqueuePosition);
+            }
+
+            ref var slot = ref _slots[position & _mask];
+            slot.Ticks = DateTime.UtcNow.Ticks;
+            slot.Level = level;
+            slot.Message = message;
+            // Publish the slot to the consumer
+            Volatile.Write(ref slot.Sequence, position + 1);
+        }
+
+        private void Consume()
+        {
+            while (true)
+            {
+                _signal.WaitOne(FlushPeriodMs);
+
+                lock (_consumerLock)
+                {
+                    if (Drain() > 0)
+                        _sink.Flush();
+                }
+            }
+        }
+
+        private int Drain()
+        {
+            var count = 0;
+            while (true)
+            {
+                ref var slot = ref _slots[_dequeuePosition & _mask];
+                if (Volatile.Read(ref slot.Sequence) != _dequeuePosition + 1)
+                    break;
+
+                var time = new DateTime(slot.Ticks, DateTimeKind.Utc).ToLocalTime();
+                var level = slot.Level;
+                var message = slot.Message;
+                slot.Message = null;
+                // Release the slot for the next lap of the producers
+                Volatile.Write(ref slot.Sequence, _dequeuePosition + _mask + 1);
+                _dequeuePosition++;
+
+                Write(time, level, message);
+                count++;
+            }
+
+            var dropped = Interlocked.Read(ref _dropped) - _reportedDropped;
+            if (dropped > 0)
+            {
+                _reportedDropped += dropped;
+                Write(DateTime.Now, LogLevel.Warn, $"{dropped} log messages have been dropped, the buffer was full");
+                count++;
+            }
+
+            return count;
+        }
+
+        private void Write(DateTime time, LogLevel level, string message)
+        {
+            try
+            {
+                _sink.Write(time, level, message);
+            }
+            catch (Exception)
+            {
+                // A failing sink shouldn't stop the consumer thread
+            }
+        }
+
+        private struct Slot
+        {
+            public long Sequence;
+            public long Ticks;
+            public LogLevel Level;
+            public string Message;
+        }
+    }
+}
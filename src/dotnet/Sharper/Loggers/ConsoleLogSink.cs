@@ -0,0 +1,20 @@
+﻿using System;
+
+namespace Sharper.Loggers
+{
+    /// <summary>
+    /// Writes the log messages on the standard error, which is the R console when R runs in a terminal.
+    /// R can't be called back from the logger thread, so the messages don't go through the R console API.
+    /// </summary>
+    public class ConsoleLogSink : ILogSink
+    {
+        #region Implementation of ILogSink
+
+        public void Write(DateTime time, LogLevel level, string message)
+            => Console.Error.WriteLine($"{time:HH:mm:ss.fff} [{level}] {message}");
+
+        public void Flush() => Console.Error.Flush();
+
+        #endregion
+    }
+}
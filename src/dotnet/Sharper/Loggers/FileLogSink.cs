@@ -0,0 +1,24 @@
+﻿using System;
+using System.IO;
+
+namespace Sharper.Loggers
+{
+    public class FileLogSink : ILogSink
+    {
+        private readonly StreamWriter _writer;
+
+        public FileLogSink(string filePath)
+        {
+            _writer = new StreamWriter(new FileStream(filePath, FileMode.Append, FileAccess.Write, FileShare.Read));
+        }
+
+        #region Implementation of ILogSink
+
+        public void Write(DateTime time, LogLevel level, string message)
+            => _writer.WriteLine($"{time:yyyy-MM-dd HH:mm:ss.fff} [{level}] {message}");
+
+        public void Flush() => _writer.Flush();
+
+        #endregion
+    }
+}
@@ -0,0 +1,24 @@
+﻿using System;
+
+namespace Sharper.Loggers
+{
+    /// <summary>
+    /// Defines where the log messages are written.
+    /// The messages are written by a single background thread, see <see cref="AsyncLogger"/>.
+    /// </summary>
+    public interface ILogSink
+    {
+        /// <summary>
+        /// Writes a log message.
+        /// </summary>
+        /// <param name="time">Local time of the message.</param>
+        /// <param name="level">Level of the message.</param>
+        /// <param name="message">Message to write.</param>
+        void Write(DateTime time, LogLevel level, string message);
+
+        /// <summary>
+        /// Flushes the written messages, called once a batch of messages has been written.
+        /// </summary>
+        void Flush();
+    }
+}
@@ -35,6 +35,30 @@ namespace Sharper.Loggers
         /// <param name="args">Arguments to format.</param>
         void DebugFormat(string format, params object[] args);
 
+        /// <summary>
+        /// Log a Debug level message with a format syntax, the arguments are neither boxed nor formatted when the level is disabled.
+        /// </summary>
+        /// <param name="format">String format</param>
+        /// <param name="arg1">Argument 1 to format.</param>
+        void DebugFormat<T1>(string format, T1 arg1);
+
+        /// <summary>
+        /// Log a Debug level message with a format syntax, the arguments are neither boxed nor formatted when the level is disabled.
+        /// </summary>
+        /// <param name="format">String format</param>
+        /// <param name="arg1">Argument 1 to format.</param>
+        /// <param name="arg2">Argument 2 to format.</param>
+        void DebugFormat<T1, T2>(string format, T1 arg1, T2 arg2);
+
+        /// <summary>
+        /// Log a Debug level message with a format syntax, the arguments are neither boxed nor formatted when the level is disabled.
+        /// </summary>
+        /// <param name="format">String format</param>
+        /// <param name="arg1">Argument 1 to format.</param>
+        /// <param name="arg2">Argument 2 to format.</param>
+        /// <param name="arg3">Argument 3 to format.</param>
+        void DebugFormat<T1, T2, T3>(string format, T1 arg1, T2 arg2, T3 arg3);
+
         /// <summary>
         /// Log a Debug level message with its exception.
         /// </summary>
@@ -60,6 +84,30 @@ namespace Sharper.Loggers
         /// <param name="args">Arguments to format.</param>
         void InfoFormat(string format, params object[] args);
 
+        /// <summary>
+        /// Log an Info level message with a format syntax, the arguments are neither boxed nor formatted when the level is disabled.
+        /// </summary>
+        /// <param name="format">String format</param>
+        /// <param name="arg1">Argument 1 to format.</param>
+        void InfoFormat<T1>(string format, T1 arg1);
+
+        /// <summary>
+        /// Log an Info level message with a format syntax, the arguments are neither boxed nor formatted when the level is disabled.
+        /// </summary>
+        /// <param name="format">String format</param>
+        /// <param name="arg1">Argument 1 to format.</param>
+        /// <param name="arg2">Argument 2 to format.</param>
+        void InfoFormat<T1, T2>(string format, T1 arg1, T2 arg2);
+
+        /// <summary>
+        /// Log an Info level message with a format syntax, the arguments are neither boxed nor formatted when the level is disabled.
+        /// </summary>
+        /// <param name="format">String format</param>
+        /// <param name="arg1">Argument 1 to format.</param>
+        /// <param name="arg2">Argument 2 to format.</param>
+        /// <param name="arg3">Argument 3 to format.</param>
+        void InfoFormat<T1, T2, T3>(string format, T1 arg1, T2 arg2, T3 arg3);
+
         /// <summary>
         /// Log an Info level message with its exception.
         /// </summary>
@@ -85,6 +133,30 @@ namespace Sharper.Loggers
         /// <param name="args">Arguments to format.</param>
         void WarnFormat(string format, params object[] args);
 
+        /// <summary>
+        /// Log a Warn level message with a format syntax, the arguments are neither boxed nor formatted when the level is disabled.
+        /// </summary>
+        /// <param name="format">String format</param>
+        /// <param name="arg1">Argument 1 to format.</param>
+        void WarnFormat<T1>(string format, T1 arg1);
+
+        /// <summary>
+        /// Log a Warn level message with a format syntax, the arguments are neither boxed nor formatted when the level is disabled.
+        /// </summary>
+        /// <param name="format">String format</param>
+        /// <param name="arg1">Argument 1 to format.</param>
+        /// <param name="arg2">Argument 2 to format.</param>
+        void WarnFormat<T1, T2>(string format, T1 arg1, T2 arg2);
+
+        /// <summary>
+        /// Log a Warn level message with a format syntax, the arguments are neither boxed nor formatted when the level is disabled.
+        /// </summary>
+        /// <param name="format">String format</param>
+        /// <param name="arg1">Argument 1 to format.</param>
+        /// <param name="arg2">Argument 2 to format.</param>
+        /// <param name="arg3">Argument 3 to format.</param>
+        void WarnFormat<T1, T2, T3>(string format, T1 arg1, T2 arg2, T3 arg3);
+
         /// <summary>
         /// Log a Warn level message with its exception.
         /// </summary>
@@ -110,6 +182,30 @@ namespace Sharper.Loggers
         /// <param name="args">Arguments to format.</param>
         void ErrorFormat(string format, params object[] args);
 
+        /// <summary>
+        /// Log an Error level message with a format syntax, the arguments are neither boxed nor formatted when the level is disabled.
+        /// </summary>
+        /// <param name="format">String format</param>
+        /// <param name="arg1">Argument 1 to format.</param>
+        void ErrorFormat<T1>(string format, T1 arg1);
+
+        /// <summary>
+        /// Log an Error level message with a format syntax, the arguments are neither boxed nor formatted when the level is disabled.
+        /// </summary>
+        /// <param name="format">String format</param>
+        /// <param name="arg1">Argument 1 to format.</param>
+        /// <param name="arg2">Argument 2 to format.</param>
+        void ErrorFormat<T1, T2>(string format, T1 arg1, T2 arg2);
+
+        /// <summary>
+        /// Log an Error level message with a format syntax, the arguments are neither boxed nor formatted when the level is disabled.
+        /// </summary>
+        /// <param name="format">String format</param>
+        /// <param name="arg1">Argument 1 to format.</param>
+        /// <param name="arg2">Argument 2 to format.</param>
+        /// <param name="arg3">Argument 3 to format.</param>
+        void ErrorFormat<T1, T2, T3>(string format, T1 arg1, T2 arg2, T3 arg3);
+
         /// <summary>
         /// Log an Error level message with its exception.
         /// </summary>
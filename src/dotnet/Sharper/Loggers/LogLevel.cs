@@ -8,6 +8,7 @@
         Debug,
         Info,
         Warn,
-        Error
+        Error,
+        Off
     }
 }
\ No newline at end of file
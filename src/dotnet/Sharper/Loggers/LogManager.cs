@@ -0,0 +1,72 @@
+﻿using System;
+
+namespace Sharper.Loggers
+{
+    /// <summary>
+    /// Creates the loggers from the settings given at the CLR start up.
+    /// The settings are read from the SHARPER_LOG_LEVEL and SHARPER_LOG_SINK environment variables,
+    /// set by <c>start_dotnet_core_clr</c> on the R side.
+    /// </summary>
+    public static class LogManager
+    {
+        public const string LevelVariable = "SHARPER_LOG_LEVEL";
+        public const string SinkVariable = "SHARPER_LOG_SINK";
+
+        public const string FileSink = "file";
+        public const string ConsoleSink = "console";
+        public const string NoSink = "none";
+
+        /// <summary>
+        /// Creates a logger from the environment settings, Info level into a file by default.
+        /// </summary>
+        /// <param name="name">The logger name, the file sink writes into {name}.log</param>
+        public static ILogger CreateLogger(string name)
+        {
+            try
+            {
+                return CreateLogger(name,
+                    Environment.GetEnvironmentVariable(LevelVariable),
+                    Environment.GetEnvironmentVariable(SinkVariable));
+            }
+            catch (ArgumentException e)
+            {
+                // Wrong settings shouldn't prevent the CLR from starting
+                var logger = CreateLogger(name, null, null);
+                logger.Warn(e.Message);
+                return logger;
+            }
+        }
+
+        /// <summary>
+        /// Creates a logger.
+        /// </summary>
+        /// <param name="name">The logger name, the file sink writes into {name}.log</param>
+        /// <param name="level">The log level: Debug, Info, Warn, Error or Off. Info if empty.</param>
+        /// <param name="sink">Where to write the messages: file, console or none. file if empty.</param>
+        public static ILogger CreateLogger(string name, string level, string sink)
+        {
+            var logLevel = LogLevel.Info;
+            if (!string.IsNullOrEmpty(level) && !Enum.TryParse(level, true, out logLevel))
+                throw new ArgumentException($"Unknown log level: {level}, expected one of: {string.Join(", ", Enum.GetNames(typeof(LogLevel)))}");
+
+            ILogSink logSink;
+            switch (string.IsNullOrEmpty(sink) ? FileSink : sink.ToLowerInvariant())
+            {
+                case FileSink:
+                    logSink = new FileLogSink($"{name}.log");
+                    break;
+                case ConsoleSink:
+                    logSink = new ConsoleLogSink();
+                    break;
+                case NoSink:
+                    logSink = NullLogSink.Instance;
+                    logLevel = LogLevel.Off;
+                    break;
+                default:
+                    throw new ArgumentException($"Unknown log sink: {sink}, expected one of: {FileSink}, {ConsoleSink}, {NoSink}");
+            }
+
+            return new AsyncLogger(name, logSink) { Level = logLevel };
+        }
+    }
+}
@@ -0,0 +1,19 @@
+﻿using System;
+
+namespace Sharper.Loggers
+{
+    public class NullLogSink : ILogSink
+    {
+        public static readonly NullLogSink Instance = new NullLogSink();
+
+        private NullLogSink() { }
+
+        #region Implementation of ILogSink
+
+        public void Write(DateTime time, LogLevel level, string message) { }
+
+        public void Flush() { }
+
+        #endregion
+    }
+}
@@ -0,0 +1,152 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Linq.Expressions;
+using System.Reflection;
+using Sharper.Converters;
+
+namespace Sharper
+{
+    /// <summary>
+    /// Invokes methods and constructors through compiled delegates instead of reflection.
+    /// An invoker is compiled once per method, then a call only unboxes the arguments and boxes the result.
+    /// The out and ref arguments are written back into the arguments array as <see cref="MethodBase.Invoke(object, object[])"/> does.
+    /// A <see cref="Span{T}"/> or <see cref="ReadOnlySpan{T}"/> can't be boxed, so the invoker receives
+    /// an <see cref="RVector{T}"/> for each span parameter and converts it to a span on the call.
+    /// </summary>
+    internal sealed class MethodInvoker
+    {
+        private static readonly ConcurrentDictionary<MethodBase, MethodInvoker> invokers = new ConcurrentDictionary<MethodBase, MethodInvoker>();
+
+        /// <summary>
+        /// Gets the invoker for the given method or constructor.
+        /// </summary>
+        public static MethodInvoker Get(MethodBase method) 
+            => invokers.GetOrAdd(method, p => new MethodInvoker(p));
+
+        private MethodInvoker(MethodBase method)
+        {
+            var parameters = method.GetParameters();
+            ParameterTypes = new Type[parameters.Length];
+            for (var i = 0; i < parameters.Length; i++)
+            {
+                ParameterTypes[i] = parameters[i].ParameterType.Extract();
+                HasByRef |= parameters[i].ParameterType.IsByRef;
+            }
+
+            Invoke = Create(method);
+        }
+
+        /// <summary>
+        /// Gets the types expected for the arguments, without by ref or nullable.
+        /// </summary>
+        public Type[] ParameterTypes { get; }
+
+        /// <summary>
+        /// Gets if the method has out or ref parameters.
+        /// </summary>
+        public bool HasByRef { get; }
+
+        /// <summary>
+        /// Invokes the method from its instance, null for a static method or a constructor, and its arguments.
+        /// The methods which can't be compiled, i.e. with pointer parameters, are invoked by reflection.
+        /// </summary>
+        public Func<object, object[], object> Invoke { get; }
+
+        private static Func<object, object[], object> Create(MethodBase method)
+        {
+            try
+            {
+                return Compile(method);
+            }
+            catch (Exception)
+            {
+                if (method is ConstructorInfo ctor)
+                    return (instance, args) => ctor.Invoke(args);
+                return method.Invoke;
+            }
+        }
+
+        private static Func<object, object[], object> Compile(MethodBase method)
+        {
+            if (method.ContainsGenericParameters)
+                throw new NotSupportedException($"Open generic method can't be compiled: {method}");
+
+            var parameters = method.GetParameters();
+            var instance = Expression.Parameter(typeof(object), "instance");
+            var args = Expression.Parameter(typeof(object[]), "args");
+
+            var variables = new List<ParameterExpression>();
+            var inputs = new List<Expression>();
+            var outputs = new List<Expression>();
+            var arguments = new Expression[parameters.Length];
+            for (var i = 0; i < parameters.Length; i++)
+            {
+                var parameterType = parameters[i].ParameterType;
+                var index = Expression.Constant(i);
+                Expression arg = Expression.ArrayIndex(args, index);
+                if (parameterType.IsByRef)
+                {
+                    // The value is passed through a local, then written back into the arguments
+                    var elementType = parameterType.GetElementType();
+                    var variable = Expression.Variable(elementType, parameters[i].Name);
+                    variables.Add(variable);
+                    if (!parameters[i].IsOut)
+                        inputs.Add(Expression.Assign(variable, ConvertArgument(arg, elementType)));
+                    outputs.Add(Expression.Assign(Expression.ArrayAccess(args, index), Expression.Convert(variable, typeof(object))));
+                    arguments[i] = variable;
+                }
+                else if (parameterType.IsSpan())
+                {
+                    var vectorType = typeof(RVector<>).MakeGenericType(parameterType.GetGenericArguments()[0]);
+                    var asSpan = parameterType.GetGenericTypeDefinition() == typeof(Span<>) ? "AsSpan" : "AsReadOnlySpan";
+                    arguments[i] = Expression.Call(ConvertArgument(arg, vectorType), vectorType.GetMethod(asSpan));
+                }
+                else arguments[i] = ConvertArgument(arg, parameterType);
+            }
+
+            Expression call;
+            if (method is ConstructorInfo ctor)
+                call = Expression.New(ctor, arguments);
+            else
+            {
+                var methodInfo = (MethodInfo)method;
+                if (methodInfo.IsStatic)
+                    call = Expression.Call(methodInfo, arguments);
+                else
+                {
+                    // A struct instance is called on its boxed value, so its changes are kept as by reflection
+                    var declaringType = methodInfo.DeclaringType;
+                    var target = declaringType.IsValueType
+                        ? Expression.Unbox(instance, declaringType)
+                        : Expression.Convert(instance, declaringType);
+                    call = Expression.Call(target, methodInfo, arguments);
+                }
+            }
+
+            var result = Expression.Variable(typeof(object), "result");
+            variables.Add(result);
+
+            var body = new List<Expression>(inputs);
+            body.Add(call.Type == typeof(void)
+                ? (Expression)Expression.Block(call, Expression.Assign(result, Expression.Constant(null)))
+                : Expression.Assign(result, Expression.Convert(call, typeof(object))));
+            body.AddRange(outputs);
+            body.Add(result);
+
+            return Expression.Lambda<Func<object, object[], object>>(Expression.Block(variables, body), instance, args).Compile();
+        }
+
+        private static Expression ConvertArgument(Expression arg, Type type)
+        {
+            if (!type.IsValueType)
+                return Expression.Convert(arg, type);
+
+            // A missing value gives the default one as by reflection, instead of unboxing null
+            return Expression.Condition(
+                Expression.Equal(arg, Expression.Constant(null)),
+                Expression.Default(type),
+                Expression.Convert(arg, type));
+        }
+    }
+}
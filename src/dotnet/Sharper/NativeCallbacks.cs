@@ -0,0 +1,100 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace Sharper
+{
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    internal delegate long AllocVector(int type, long length, out IntPtr data);
+
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    internal delegate void CallCompleted(int handle);
+
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    internal delegate long AllocArrowBatch(out IntPtr schema, out IntPtr array);
+
+    /// <summary>
+    /// Native functions exported by the host, which the managed code can call back.
+    /// Unless stated otherwise they use the R API, so they can only be called from the R thread during a call from R.
+    /// </summary>
+    internal static class NativeCallbacks
+    {
+        private static AllocVector allocVector;
+        private static CallCompleted callCompleted;
+        private static AllocArrowBatch allocArrowBatch;
+        private static int rThreadId;
+
+        public static bool IsRegistered => allocVector != null;
+
+        /// <summary>
+        /// Registers the callbacks, from the R thread which starts the CLR.
+        /// </summary>
+        public static void Register(IntPtr allocVectorPtr, IntPtr callCompletedPtr, IntPtr allocArrowBatchPtr)
+        {
+            rThreadId = Thread.CurrentThread.ManagedThreadId;
+            allocVector = allocVectorPtr == IntPtr.Zero 
+                ? null 
+                : Marshal.GetDelegateForFunctionPointer<AllocVector>(allocVectorPtr);
+            callCompleted = callCompletedPtr == IntPtr.Zero
+                ? null
+                : Marshal.GetDelegateForFunctionPointer<CallCompleted>(callCompletedPtr);
+            allocArrowBatch = allocArrowBatchPtr == IntPtr.Zero
+                ? null
+                : Marshal.GetDelegateForFunctionPointer<AllocArrowBatch>(allocArrowBatchPtr);
+        }
+
+        /// <summary>
+        /// Notifies the host that an async call has completed, so R can resolve its future from its event loop.
+        /// It doesn't use the R API and can be called from any thread.
+        /// </summary>
+        public static void CallCompleted(int handle) => callCompleted?.Invoke(handle);
+
+        /// <summary>
+        /// Allocates an R vector preserved from the R garbage collector until the current call returns to R.
+        /// </summary>
+        /// <param name="type">The R SEXPTYPE: 14 for numeric, 13 for integer and 10 for logical.</param>
+        /// <param name="length">The vector length.</param>
+        /// <param name="data">The pointer on the vector data.</param>
+        /// <returns>The SEXP pointer.</returns>
+        public static IntPtr AllocVector(int type, long length, out IntPtr data)
+        {
+            if (allocVector == null)
+                throw new InvalidOperationException("The native host didn't register its callbacks, R vectors can't be allocated");
+            CheckRThread("R vectors");
+
+            var sexp = allocVector(type, length, out data);
+            if (sexp == 0)
+                throw new OutOfMemoryException($"Unable to allocate an R vector of type: {type}, length: {length}");
+
+            return new IntPtr(sexp);
+        }
+
+        /// <summary>
+        /// Allocates the Arrow C data interface structs of a record batch, held by an R external pointer
+        /// preserved from the R garbage collector until the current call returns to R.
+        /// R imports the exported batch without any copy once the call returns.
+        /// </summary>
+        /// <param name="schema">The pointer on the empty ArrowSchema struct.</param>
+        /// <param name="array">The pointer on the empty ArrowArray struct.</param>
+        /// <returns>The SEXP pointer.</returns>
+        public static IntPtr AllocArrowBatch(out IntPtr schema, out IntPtr array)
+        {
+            if (allocArrowBatch == null)
+                throw new InvalidOperationException("The native host didn't register its callbacks, arrow batches can't be allocated");
+            CheckRThread("Arrow batches");
+
+            var sexp = allocArrowBatch(out schema, out array);
+            if (sexp == 0)
+                throw new OutOfMemoryException("Unable to allocate an arrow batch");
+
+            return new IntPtr(sexp);
+        }
+
+        // R isn't thread safe, an allocation from another thread, i.e. an async call on the thread pool, could corrupt its heap
+        private static void CheckRThread(string what)
+        {
+            if (Thread.CurrentThread.ManagedThreadId != rThreadId)
+                throw new InvalidOperationException($"{what} can only be allocated from the R thread, not from an async call");
+        }
+    }
+}
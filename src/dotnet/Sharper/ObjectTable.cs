@@ -0,0 +1,123 @@
+﻿using System;
+
+namespace Sharper
+{
+    /// <summary>
+    /// Holds the .Net objects referenced from R, each one by a handle stored as the address of its R external pointer.
+    /// The slots are allocated by slabs which are never moved, the freed slots are reused from a free list.
+    /// A handle packs the slot index with the slot generation, which is incremented when the slot is freed,
+    /// so a stale handle, i.e. released twice, is detected instead of giving another object.
+    /// </summary>
+    public static class ObjectTable
+    {
+        private const int SLAB_BITS = 12;
+        private const int SLAB_SIZE = 1 << SLAB_BITS;
+        private const int SLAB_MASK = SLAB_SIZE - 1;
+
+        private static readonly object locker = new object();
+        private static Slot[][] slabs = new Slot[16][];
+        private static int slabsCount;
+        private static int freeSlot = -1;
+        private static int count;
+
+        /// <summary>
+        /// Gets the number of referenced objects.
+        /// </summary>
+        public static int Count => count;
+
+        /// <summary>
+        /// References an object and gets its handle, which is never 0.
+        /// An object referenced many times gets a handle each time, and is kept alive until all of them are released.
+        /// </summary>
+        public static IntPtr Add(object instance)
+        {
+            if (instance == null)
+                throw new ArgumentNullException(nameof(instance));
+
+            lock (locker)
+            {
+                if (freeSlot < 0)
+                    AddSlab();
+
+                var index = freeSlot;
+                ref var slot = ref slabs[index >> SLAB_BITS][index & SLAB_MASK];
+                freeSlot = slot.NextFree;
+                slot.Instance = instance;
+                slot.NextFree = -1;
+                count++;
+
+                return ToHandle(index, slot.Generation);
+            }
+        }
+
+        /// <summary>
+        /// Gets the object referenced by a handle.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">The handle has been released or doesn't come from this table.</exception>
+        public static object Get(IntPtr handle)
+        {
+            lock (locker)
+            {
+                return GetSlot(handle).Instance;
+            }
+        }
+
+        /// <summary>
+        /// Releases the reference held by a handle, the handle is stale afterwards.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">The handle has already been released or doesn't come from this table.</exception>
+        public static void Release(IntPtr handle)
+        {
+            lock (locker)
+            {
+                ref var slot = ref GetSlot(handle);
+                slot.Instance = null;
+                slot.Generation++;
+                slot.NextFree = freeSlot;
+                freeSlot = (int)((long)handle & uint.MaxValue) - 1;
+                count--;
+            }
+        }
+
+        private static ref Slot GetSlot(IntPtr handle)
+        {
+            var value = (long)handle;
+            var index = (int)(value & uint.MaxValue) - 1;
+            var generation = (int)(value >> 32);
+
+            if (index < 0 || index >= slabsCount << SLAB_BITS)
+                throw new ObjectDisposedException($"Handle: {value}", "The .Net object handle is unknown");
+
+            ref var slot = ref slabs[index >> SLAB_BITS][index & SLAB_MASK];
+            if (slot.Generation != generation || slot.Instance == null)
+                throw new ObjectDisposedException($"Handle: {value}", "The .Net object has already been released");
+
+            return ref slot;
+        }
+
+        private static IntPtr ToHandle(int index, int generation)
+            => new IntPtr(((long)generation << 32) | (uint)(index + 1));
+
+        private static void AddSlab()
+        {
+            if (slabsCount == slabs.Length)
+                Array.Resize(ref slabs, slabs.Length * 2);
+
+            // The new slots are chained in order, so they are given in order
+            var slab = new Slot[SLAB_SIZE];
+            var first = slabsCount << SLAB_BITS;
+            for (var i = 0; i < SLAB_SIZE; i++)
+                slab[i].NextFree = i < SLAB_SIZE - 1 ? first + i + 1 : -1;
+
+            slabs[slabsCount++] = slab;
+            freeSlot = first;
+        }
+
+        private struct Slot
+        {
+            public object Instance;
+            public int Generation;
+            public int NextFree;
+        }
+    }
+}
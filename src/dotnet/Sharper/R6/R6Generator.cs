@@ -67,9 +67,26 @@ namespace Sharper.R6
         {
             var properties = new List<string>();
             foreach (var property in type.GetPublicProperties())
+            {
+                // An indexer needs its index arguments, so it keeps the dynamic accessors
+                var isIndexer = property.GetIndexParameters().Length > 0;
+                var getter = isIndexer ? null : property.GetGetMethod();
+                var setter = isIndexer ? null : property.GetSetMethod();
+                var valueParameter = setter?.GetParameters()[0];
+
                 properties.Add(r6PropertyTemplate
                     .Replace("{{PropertyName}}", property.Name)
+                    .Replace("{{PrepareGet}}", type.GeneratePrepare(getter, "    ", out var getSite))
+                    .Replace("{{Get}}", getSite != null
+                        ? $"netCallPrepared({getSite}, x = private$ptr, wrap = TRUE)"
+                        : $"self$get(\"{property.Name}\")")
+                    .Replace("{{PrepareSet}}", type.GeneratePrepare(setter, "    ", out var setSite)
+                        + valueParameter.GenerateCoercion("    "))
+                    .Replace("{{Set}}", setSite != null
+                        ? $"netCallPrepared({setSite}, value, x = private$ptr)"
+                        : $"self$set(\"{property.Name}\", value)")
                     .Replace("{{Description}}", property.GetDescription()));
+            }
 
             var ctorParameters = type.GetCtorParameters();
             var ctor = r6CtorTemplate
@@ -86,10 +103,20 @@ namespace Sharper.R6
             foreach (var method in type.GetPublicMethods())
             {
                 var methodParameters = method.GetParameters();
+                var hasByRefParams = methodParameters.Any(p => p.ParameterType.IsByRef);
+                var prepare = type.GeneratePrepare(method, "  ", out var site);
+                // The arguments of a method with out or ref arguments are assigned back to the caller, so they aren't coerced
+                if (!hasByRefParams)
+                    prepare += string.Concat(methodParameters.Select(p => p.GenerateCoercion("  ")));
+
                 methods.Add(r6MethodTemplate
                     .Replace("{{MethodName}}", method.GetUniqueName(methodNameCounter))
+                    .Replace("{{Prepare}}", prepare)
+                    .Replace("{{Call}}", site != null
+                        ? $"netCallPrepared({site}, x = private$ptr"
+                        : $"self$call(\"{method.Name}\"")
                     .Replace("{{Parameters}}", methodParameters.GenerateR6Parameters())
-                    .Replace("{{HasByRefParams}}", methodParameters.Any(p => p.ParameterType.IsByRef).ToString().ToUpper())
+                    .Replace("{{HasByRefParams}}", hasByRefParams.ToString().ToUpper())
                     .Replace("{{Comma}}", methodParameters.GenerateComma())
                     .Replace("{{Return}}", method.ReturnType == typeof(void) ? "invisible" : "return")
                     .Replace("{{Description}}", type.GetDescription())
@@ -116,6 +143,101 @@ namespace Sharper.R6
         private static string GenerateComma<T>(this IEnumerable<T> source) 
             => source.Any() ? "," : string.Empty;
 
+        /// <summary>
+        /// Generates the R code which prepares the call site of a method on its first call, then reuses it.
+        /// The call site handles only live in the current process, so they can't be written in the generated file,
+        /// the method is identified by its declaring type name and its parameter type names instead.
+        /// </summary>
+        /// <param name="type">The generated type.</param>
+        /// <param name="method">The method to prepare, null to keep a dynamic call.</param>
+        /// <param name="indent">The indentation of the generated lines.</param>
+        /// <param name="site">The R variable of the call site, null if the method can't be prepared.</param>
+        /// <returns>The generated lines, empty if the method can't be prepared.</returns>
+        private static string GeneratePrepare(this Type type, MethodInfo method, string indent, out string site)
+        {
+            site = null;
+            if (method == null || method.IsGenericMethodDefinition)
+                return string.Empty;
+
+            var argTypes = method.GetParameters()
+                .Select(p => p.ParameterType.GetParameterTypeName())
+                .ToArray();
+            if (argTypes.Any(p => p == null))
+                return string.Empty;
+
+            // The names drop Nullable and by ref, so M(int?) or M(ref int) would give the same names as M(int)
+            // and netPrepare could bind either of them. These overloads keep the dynamic call.
+            var isAmbiguous = type.GetMethods(BindingFlags.Public | BindingFlags.Instance | BindingFlags.Static)
+                .Where(p => p.Name == method.Name && (p.MetadataToken != method.MetadataToken || p.Module != method.Module))
+                .Any(p => p.GetParameters().Select(q => q.ParameterType.GetParameterTypeName()).SequenceEqual(argTypes));
+            if (isAmbiguous)
+                return string.Empty;
+
+            var key = $"{type.FullName}.{method.Name}({string.Join(", ", argTypes)})";
+            var argTypesVector = argTypes.Length == 0
+                ? "character(0)"
+                : $"c({string.Join(", ", argTypes.Select(p => $"\"{p}\""))})";
+
+            // Dotted, so it doesn't hide a parameter
+            site = ".site";
+            var sb = new StringBuilder();
+            sb.AppendLine($"{indent}{site} <- private$sites[[\"{key}\"]]");
+            sb.AppendLine($"{indent}if (is.null({site})) {site} <- private$sites[[\"{key}\"]] <- netPrepare(\"{type.FullName}\", \"{method.Name}\", {argTypesVector}, static = FALSE)");
+            return sb.ToString();
+        }
+
+        /// <summary>
+        /// Generates the R code which coerces an argument into the R type expected by its .Net parameter,
+        /// so a prepared call doesn't have to convert it.
+        /// Only a compatible R type is coerced, any other argument raises an error instead of being silently
+        /// truncated or turned into NA.
+        /// </summary>
+        private static string GenerateCoercion(this ParameterInfo parameter, string indent)
+        {
+            if (parameter == null || parameter.ParameterType.IsByRef)
+                return string.Empty;
+
+            var type = parameter.ParameterType.Extract();
+            if (type.IsArray && type.GetArrayRank() == 1)
+                type = type.GetElementType();
+
+            var name = parameter.Name;
+            string invalid, coercion, expected;
+            if (type == typeof(double) || type == typeof(float))
+            {
+                invalid = $"!is.numeric({name})";
+                coercion = "as.double";
+                expected = "numeric";
+            }
+            else if (type == typeof(int))
+            {
+                invalid = $"!is.numeric({name}) || any({name} != trunc({name}), na.rm = TRUE)";
+                coercion = "as.integer";
+                expected = "whole numbers";
+            }
+            else if (type == typeof(bool))
+            {
+                invalid = $"!is.logical({name})";
+                coercion = "as.logical";
+                expected = "logical";
+            }
+            else if (type == typeof(string))
+            {
+                invalid = $"!is.character({name}) && !is.factor({name})";
+                coercion = "as.character";
+                expected = "character or a factor";
+            }
+            else
+                return string.Empty;
+
+            var sb = new StringBuilder();
+            sb.AppendLine($"{indent}if (!is.null({name})) {{");
+            sb.AppendLine($"{indent}  if ({invalid}) stop(\"{name} should be {expected}\")");
+            sb.AppendLine($"{indent}  {name} <- {coercion}({name})");
+            sb.AppendLine($"{indent}}}");
+            return sb.ToString();
+        }
+
         private static string GenerateR6ParametersDoc(this ParameterInfo[] parameters)
         {
             var sb = new StringBuilder();
@@ -0,0 +1,169 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Reflection;
+using System.Threading;
+using Sharper.Converters;
+
+namespace Sharper
+{
+    /// <summary>
+    /// Memoises the reflection lookups of the calls which aren't prepared:
+    /// the full hierarchy of a type, and the overload chosen for a member name and the types its arguments can be converted into.
+    /// A call repeated with the same kinds of R arguments, or .Net objects of the same types, skips the scoring of the overloads.
+    /// </summary>
+    /// <remarks>
+    /// The converters share their types arrays between arguments of the same kind, so a signature is mostly compared by references.
+    /// The chosen overload only depends on these types, so a cached overload is the one which would have been scored.
+    /// </remarks>
+    public static class ResolutionCache
+    {
+        private const int MAX_SIZE = 4096;
+
+        private static readonly ConcurrentDictionary<Type, Type[]> hierarchies = new ConcurrentDictionary<Type, Type[]>();
+        private static readonly ConcurrentDictionary<OverloadKey, MethodBase> overloads = new ConcurrentDictionary<OverloadKey, MethodBase>();
+
+        private static long hierarchyHits;
+        private static long hierarchyMisses;
+        private static long overloadHits;
+        private static long overloadMisses;
+
+        /// <summary>
+        /// Gets the full hierarchy of a type, computed once per type.
+        /// The result is shared, so it mustn't be modified.
+        /// </summary>
+        public static Type[] GetFullHierarchy(Type type, Func<Type, Type[]> factory)
+        {
+            if (hierarchies.TryGetValue(type, out var hierarchy))
+            {
+                Interlocked.Increment(ref hierarchyHits);
+                return hierarchy;
+            }
+
+            Interlocked.Increment(ref hierarchyMisses);
+            return hierarchies.GetOrAdd(type, factory);
+        }
+
+        /// <summary>
+        /// Gets the overload of a member which best matches the converters, resolved once per types of the converters.
+        /// An overload which isn't found isn't cached, so the lookup is done again to report the error.
+        /// </summary>
+        public static MethodBase GetOverload(Type type, string name, BindingFlags flags, IConverter[] converters,
+            Func<Type, string, BindingFlags, IConverter[], MethodBase> resolve)
+        {
+            var signature = new Type[converters.Length][];
+            for (var i = 0; i < signature.Length; i++)
+                signature[i] = converters[i].GetClrTypes();
+
+            var key = new OverloadKey(type, name, flags, signature);
+            if (overloads.TryGetValue(key, out var method))
+            {
+                Interlocked.Increment(ref overloadHits);
+                return method;
+            }
+
+            Interlocked.Increment(ref overloadMisses);
+            method = resolve(type, name, flags, converters);
+            if (method == null) return null;
+
+            // The signatures used by a session are few, so the cache is only cleared when it is flooded
+            if (overloads.Count >= MAX_SIZE)
+                overloads.Clear();
+            overloads[key] = method;
+
+            return method;
+        }
+
+        /// <summary>
+        /// Clears the hit and miss counters, the cached lookups are kept.
+        /// </summary>
+        public static void ResetStatistics()
+        {
+            Interlocked.Exchange(ref hierarchyHits, 0);
+            Interlocked.Exchange(ref hierarchyMisses, 0);
+            Interlocked.Exchange(ref overloadHits, 0);
+            Interlocked.Exchange(ref overloadMisses, 0);
+        }
+
+        /// <summary>
+        /// Gets the hit and miss counters and the size of each cache, as columns.
+        /// </summary>
+        public static Dictionary<string, object> GetStatistics()
+        {
+            return new Dictionary<string, object>
+            {
+                { "cache", new[] { "hierarchy", "overload" } },
+                { "hits", new[] { (double)Interlocked.Read(ref hierarchyHits), Interlocked.Read(ref overloadHits) } },
+                { "misses", new[] { (double)Interlocked.Read(ref hierarchyMisses), Interlocked.Read(ref overloadMisses) } },
+                { "size", new[] { hierarchies.Count, overloads.Count } },
+            };
+        }
+
+        private readonly struct OverloadKey : IEquatable<OverloadKey>
+        {
+            private readonly Type _type;
+            private readonly string _name;
+            private readonly BindingFlags _flags;
+            private readonly Type[][] _signature;
+            private readonly int _hashCode;
+
+            public OverloadKey(Type type, string name, BindingFlags flags, Type[][] signature)
+            {
+                _type = type;
+                _name = name;
+                _flags = flags;
+                _signature = signature;
+
+                // Hashes the bounds of each types array only, equal arrays have the same bounds
+                var hashCode = (type.GetHashCode() * 397) ^ (name?.GetHashCode() ?? 0);
+                hashCode = (hashCode * 397) ^ (int)flags;
+                for (var i = 0; i < signature.Length; i++)
+                {
+                    var types = signature[i];
+                    hashCode = (hashCode * 397) ^ types.Length;
+                    if (types.Length > 0)
+                        hashCode = (hashCode * 397) ^ types[0].GetHashCode() ^ types[types.Length - 1].GetHashCode();
+                }
+                _hashCode = hashCode;
+            }
+
+            public bool Equals(OverloadKey other)
+            {
+                if (_hashCode != other._hashCode
+                    || _type != other._type
+                    || _flags != other._flags
+                    || !string.Equals(_name, other._name)
+                    || _signature.Length != other._signature.Length)
+                    return false;
+
+                for (var i = 0; i < _signature.Length; i++)
+                {
+                    if (!AreEqual(_signature[i], other._signature[i]))
+                        return false;
+                }
+                return true;
+            }
+
+            public override bool Equals(object obj) => obj is OverloadKey other && Equals(other);
+
+            public override int GetHashCode() => _hashCode;
+
+            private static bool AreEqual(Type[] x, Type[] y)
+            {
+                if (ReferenceEquals(x, y)) return true;
+                if (x.Length != y.Length) return false;
+
+                // The null converter types are matched by reference when scoring
+                if (ReferenceEquals(x, NullConverter.Types) || ReferenceEquals(y, NullConverter.Types))
+                    return false;
+
+                for (var i = 0; i < x.Length; i++)
+                {
+                    if (x[i] != y[i])
+                        return false;
+                }
+                return true;
+            }
+        }
+    }
+}
@@ -0,0 +1,33 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime;
+using System.Runtime.InteropServices;
+
+namespace Sharper
+{
+    /// <summary>
+    /// Reports the settings the runtime actually applies, to check the properties given at the CoreCLR start up.
+    /// </summary>
+    public static class RuntimeSettings
+    {
+        public static Dictionary<string, object> GetEffectiveSettings()
+        {
+            var settings = new Dictionary<string, object>
+            {
+                { "framework", RuntimeInformation.FrameworkDescription },
+                { "processor_count", Environment.ProcessorCount },
+                { "server_gc", GCSettings.IsServerGC },
+                { "concurrent_gc", GCSettings.LatencyMode != GCLatencyMode.Batch },
+                { "gc_latency_mode", GCSettings.LatencyMode.ToString() }
+            };
+
+            // The memory available to the GC, bounded by GCHeapHardLimit when it's set (.Net Core 3.0+)
+            var memoryInfo = typeof(GC).GetMethod("GetGCMemoryInfo", Type.EmptyTypes)?.Invoke(null, null);
+            var totalAvailable = memoryInfo?.GetType().GetProperty("TotalAvailableMemoryBytes")?.GetValue(memoryInfo);
+            if (totalAvailable != null)
+                settings.Add("gc_total_available_bytes", Convert.ToDouble(totalAvailable));
+
+            return settings;
+        }
+    }
+}
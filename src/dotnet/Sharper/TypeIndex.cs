@@ -0,0 +1,162 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Linq;
+using System.Reflection;
+
+namespace Sharper
+{
+    /// <summary>
+    /// Indexes the loaded types by full name and by 'Namespace.Type, Assembly' name,
+    /// so a type is resolved without scanning all the loaded assemblies.
+    /// The assemblies are recorded when they are loaded, their types are indexed on the first lookup which misses.
+    /// </summary>
+    public static class TypeIndex
+    {
+        private static readonly ConcurrentDictionary<string, Type> byFullName = new ConcurrentDictionary<string, Type>();
+        private static readonly ConcurrentDictionary<string, Type> byQualifiedName = new ConcurrentDictionary<string, Type>();
+        private static readonly ConcurrentDictionary<string, Assembly> byAssemblyName = new ConcurrentDictionary<string, Assembly>();
+        private static readonly ConcurrentDictionary<string, Assembly> byModuleName = new ConcurrentDictionary<string, Assembly>();
+        private static readonly ConcurrentQueue<Assembly> pendingAssemblies = new ConcurrentQueue<Assembly>();
+        private static readonly List<Assembly> dynamicAssemblies = new List<Assembly>();
+        private static readonly object locker = new object();
+
+        static TypeIndex()
+        {
+            // Subscribe first to never miss an assembly, a duplicate is ignored
+            AppDomain.CurrentDomain.AssemblyLoad += (s, e) => Add(e.LoadedAssembly);
+            foreach (var assembly in AppDomain.CurrentDomain.GetAssemblies())
+                Add(assembly);
+        }
+
+        /// <summary>
+        /// Gets the number of indexed types.
+        /// </summary>
+        public static int Count
+        {
+            get
+            {
+                IndexPendingAssemblies();
+                return byFullName.Count;
+            }
+        }
+
+        /// <summary>
+        /// Gets a loaded assembly from its simple name, i.e. 'AssemblyForTests'.
+        /// </summary>
+        public static bool TryGetAssembly(string assemblyName, out Assembly assembly)
+            => byAssemblyName.TryGetValue(assemblyName, out assembly);
+
+        /// <summary>
+        /// Gets a loaded assembly from its module file name, i.e. 'AssemblyForTests.dll'.
+        /// </summary>
+        public static bool TryGetAssemblyByFileName(string fileName, out Assembly assembly)
+            => byModuleName.TryGetValue(fileName, out assembly);
+
+        /// <summary>
+        /// Gets a type from its full name.
+        /// </summary>
+        public static bool TryGetType(string fullName, out Type type)
+        {
+            if (byFullName.TryGetValue(fullName, out type))
+                return true;
+
+            if (IndexPendingAssemblies() && byFullName.TryGetValue(fullName, out type))
+                return true;
+
+            return TryGetDynamicType(fullName, out type);
+        }
+
+        /// <summary>
+        /// Gets a type from its full name and its assembly simple name.
+        /// </summary>
+        public static bool TryGetType(string fullName, string assemblyName, out Type type)
+        {
+            var key = GetQualifiedName(fullName, assemblyName);
+            if (byQualifiedName.TryGetValue(key, out type))
+                return true;
+
+            if (IndexPendingAssemblies() && byQualifiedName.TryGetValue(key, out type))
+                return true;
+
+            // The dynamic assemblies can define types after they are loaded
+            type = TryGetAssembly(assemblyName, out var assembly) && assembly.IsDynamic
+                ? assembly.GetType(fullName)
+                : null;
+            return type != null;
+        }
+
+        private static void Add(Assembly assembly)
+        {
+            var name = assembly.GetName().Name;
+            if (name == null || !byAssemblyName.TryAdd(name, assembly))
+                return;
+
+            if (assembly.IsDynamic)
+            {
+                lock (dynamicAssemblies)
+                    dynamicAssemblies.Add(assembly);
+                return;
+            }
+
+            byModuleName.TryAdd(assembly.ManifestModule.Name, assembly);
+            pendingAssemblies.Enqueue(assembly);
+        }
+
+        private static bool IndexPendingAssemblies()
+        {
+            if (pendingAssemblies.IsEmpty) return false;
+
+            lock (locker)
+            {
+                while (pendingAssemblies.TryDequeue(out var assembly))
+                {
+                    var assemblyName = assembly.GetName().Name;
+                    foreach (var type in GetTypes(assembly))
+                    {
+                        var fullName = type.FullName;
+                        if (fullName == null) continue;
+
+                        // As the assemblies scan, the first loaded type wins for a full name
+                        byFullName.TryAdd(fullName, type);
+                        byQualifiedName.TryAdd(GetQualifiedName(fullName, assemblyName), type);
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        private static bool TryGetDynamicType(string fullName, out Type type)
+        {
+            lock (dynamicAssemblies)
+            {
+                foreach (var assembly in dynamicAssemblies)
+                {
+                    type = assembly.GetType(fullName);
+                    if (type != null)
+                        return true;
+                }
+            }
+
+            type = null;
+            return false;
+        }
+
+        private static IEnumerable<Type> GetTypes(Assembly assembly)
+        {
+            try
+            {
+                return assembly.GetTypes();
+            }
+            catch (ReflectionTypeLoadException e)
+            {
+                // Keeps the types which have been loaded
+                return e.Types.Where(p => p != null);
+            }
+        }
+
+        private static string GetQualifiedName(string fullName, string assemblyName)
+            => fullName + ", " + assemblyName;
+    }
+}
@@ -0,0 +1,15 @@
+﻿namespace System.Runtime.InteropServices
+{
+    /// <summary>
+    /// Defined here because netstandard2.0 doesn't expose it. The runtime recognizes the attribute from its full name,
+    /// so from .Net 5 the marked methods are called directly by the native host without any marshalling stub.
+    /// An older runtime ignores it and creates a regular delegate, which stays cheap because the signatures are blittable.
+    /// </summary>
+    [AttributeUsage(AttributeTargets.Method, Inherited = false)]
+    internal sealed class UnmanagedCallersOnlyAttribute : Attribute
+    {
+        public Type[] CallConvs;
+
+        public string EntryPoint;
+    }
+}
@@ -0,0 +1,130 @@
+﻿using System.Runtime.InteropServices;
+
+namespace Sharper
+{
+    /// <summary>
+    /// Blittable entry points for the native host, which forward to <see cref="ClrProxy"/>.
+    /// The names are given as UTF-8 data plus length, the booleans as integers and the outputs as pointers.
+    /// The native host falls back to the <see cref="ClrProxy"/> marshalled entry points if they can't be bound.
+    /// </summary>
+    public static unsafe class UnmanagedEntryPoints
+    {
+        [UnmanagedCallersOnly]
+        public static int CallStaticMethod(
+            byte* typeName, int typeNameLength,
+            byte* methodName, int methodNameLength,
+            long* argumentsPtr, long* argumentsData, int argumentsSize,
+            long* results, int resultsCapacity, int* resultsSize)
+        {
+            return ClrProxy.CallStaticMethod(
+                Utf8Names.Get(typeName, typeNameLength), 
+                Utf8Names.Get(methodName, methodNameLength), 
+                argumentsPtr, argumentsData, argumentsSize, 
+                results, resultsCapacity, out *resultsSize) ? 1 : 0;
+        }
+
+        [UnmanagedCallersOnly]
+        public static int GetStaticProperty(
+            byte* typeName, int typeNameLength,
+            byte* propertyName, int propertyNameLength,
+            long* value)
+        {
+            return ClrProxy.GetStaticProperty(
+                Utf8Names.Get(typeName, typeNameLength), 
+                Utf8Names.Get(propertyName, propertyNameLength), 
+                out *value) ? 1 : 0;
+        }
+
+        [UnmanagedCallersOnly]
+        public static int SetStaticProperty(
+            byte* typeName, int typeNameLength,
+            byte* propertyName, int propertyNameLength,
+            long argumentPtr)
+        {
+            return ClrProxy.SetStaticProperty(
+                Utf8Names.Get(typeName, typeNameLength), 
+                Utf8Names.Get(propertyName, propertyNameLength), 
+                argumentPtr) ? 1 : 0;
+        }
+
+        [UnmanagedCallersOnly]
+        public static int CreateObject(
+            byte* typeName, int typeNameLength,
+            long* argumentsPtr, long* argumentsData, int argumentsSize,
+            long* objectPtr)
+        {
+            return ClrProxy.CreateObject(
+                Utf8Names.Get(typeName, typeNameLength), 
+                argumentsPtr, argumentsData, argumentsSize, 
+                out *objectPtr) ? 1 : 0;
+        }
+
+        [UnmanagedCallersOnly]
+        public static int ReleaseObjects(long* handles, int count) 
+            => ClrProxy.ReleaseObjects(handles, count) ? 1 : 0;
+
+        [UnmanagedCallersOnly]
+        public static int CallMethod(
+            long objectPtr,
+            byte* methodName, int methodNameLength,
+            long* argumentsPtr, long* argumentsData, int argumentsSize,
+            long* results, int resultsCapacity, int* resultsSize)
+        {
+            return ClrProxy.CallMethod(
+                objectPtr, 
+                Utf8Names.Get(methodName, methodNameLength), 
+                argumentsPtr, argumentsData, argumentsSize, 
+                results, resultsCapacity, out *resultsSize) ? 1 : 0;
+        }
+
+        [UnmanagedCallersOnly]
+        public static int GetProperty(
+            long objectPtr,
+            byte* propertyName, int propertyNameLength,
+            long* value)
+        {
+            return ClrProxy.GetProperty(
+                objectPtr, 
+                Utf8Names.Get(propertyName, propertyNameLength), 
+                out *value) ? 1 : 0;
+        }
+
+        [UnmanagedCallersOnly]
+        public static int SetProperty(
+            long objectPtr,
+            byte* propertyName, int propertyNameLength,
+            long argumentPtr)
+        {
+            return ClrProxy.SetProperty(
+                objectPtr, 
+                Utf8Names.Get(propertyName, propertyNameLength), 
+                argumentPtr) ? 1 : 0;
+        }
+
+        [UnmanagedCallersOnly]
+        public static int CallPreparedMethod(
+            int handle,
+            long objectPtr,
+            long* argumentsPtr, long* argumentsData, int argumentsSize,
+            long* results, int resultsCapacity, int* resultsSize)
+        {
+            return ClrProxy.CallPreparedMethod(
+                handle, objectPtr, 
+                argumentsPtr, argumentsData, argumentsSize, 
+                results, resultsCapacity, out *resultsSize) ? 1 : 0;
+        }
+
+        [UnmanagedCallersOnly]
+        public static int CallPreparedScalar(
+            int handle,
+            long objectPtr,
+            long* arguments, int argumentsSize,
+            void* result)
+        {
+            return ClrProxy.CallPreparedScalar(
+                handle, objectPtr, 
+                arguments, argumentsSize, 
+                result) ? 1 : 0;
+        }
+    }
+}
@@ -0,0 +1,52 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Text;
+
+namespace Sharper
+{
+    /// <summary>
+    /// Decodes the UTF-8 names given by the native host, i.e. type, method or property names.
+    /// R keeps a single copy of each string, so a name comes back with the same pointer from call to call.
+    /// The decoded names are cached by pointer and checked against their bytes, which avoids a string allocation per call.
+    /// </summary>
+    internal static unsafe class Utf8Names
+    {
+        private const int MAX_SIZE = 4096;
+
+        private static readonly ConcurrentDictionary<long, Entry> cache = new ConcurrentDictionary<long, Entry>();
+
+        public static string Get(byte* data, int length)
+        {
+            if (data == null) return null;
+
+            var key = (long)data;
+            if (cache.TryGetValue(key, out var entry) && entry.Matches(data, length))
+                return entry.Value;
+
+            var value = Encoding.UTF8.GetString(data, length);
+
+            // The names used by a session are few, so the cache is only cleared when it is flooded
+            if (cache.Count >= MAX_SIZE)
+                cache.Clear();
+            cache[key] = new Entry(value, new ReadOnlySpan<byte>(data, length).ToArray());
+
+            return value;
+        }
+
+        private class Entry
+        {
+            private readonly byte[] _bytes;
+
+            public Entry(string value, byte[] bytes)
+            {
+                Value = value;
+                _bytes = bytes;
+            }
+
+            public string Value { get; }
+
+            public bool Matches(byte* data, int length) 
+                => length == _bytes.Length && new ReadOnlySpan<byte>(data, length).SequenceEqual(_bytes);
+        }
+    }
+}
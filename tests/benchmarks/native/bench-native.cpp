@@ -0,0 +1,336 @@
+// Native micro-benchmarks of the R <-> CLR call path.
+//
+// Runs headless through an embedded R session: loads the installed sharper package and the AssemblyForTests
+// assembly, then calls directly the sharper .External entry points in a C++ loop, so the R interpreter
+// isn't part of the measures. The results are printed and can be written as CSV and/or JSON to compare runs.
+//
+// Usage: bench-native [--iterations N] [--min-size N] [--max-size N] [--csv file] [--json file]
+
+#include <Rembedded.h>
+#include <Rinternals.h>
+#include <R_ext/Memory.h>
+#include <R_ext/Parse.h>
+#include <R_ext/Rdynload.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+typedef SEXP(*external_ptr)(SEXP);
+typedef std::chrono::steady_clock bench_clock;
+
+struct BenchResult
+{
+	std::string group;
+	std::string name;
+	double size;
+	long iterations;
+	double elapsedNs;
+
+	double nsPerCall() const { return elapsedNs / iterations; }
+	double callsPerSecond() const { return iterations * 1e9 / elapsedNs; }
+	double elementsPerSecond() const { return size * iterations * 1e9 / elapsedNs; }
+};
+
+struct BenchOptions
+{
+	long iterations = 100000;
+	double minSize = 1e3;
+	double maxSize = 1e8;
+	const char* csvFile = NULL;
+	const char* jsonFile = NULL;
+};
+
+struct BenchLoop
+{
+	external_ptr fn;
+	SEXP args;
+	long iterations;
+	double elapsedNs;
+};
+
+static std::vector<BenchResult> results;
+
+static double elapsedSince(bench_clock::time_point start)
+{
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - start).count();
+}
+
+static SEXP evalR(const char* code)
+{
+	ParseStatus status;
+	SEXP text = PROTECT(Rf_mkString(code));
+	SEXP exprs = PROTECT(R_ParseVector(text, -1, &status, R_NilValue));
+	if (status != PARSE_OK)
+	{
+		fprintf(stderr, "Unable to parse: %s\n", code);
+		exit(1);
+	}
+
+	SEXP result = R_NilValue;
+	for (int i = 0; i < Rf_length(exprs); i++)
+	{
+		int hasError = 0;
+		result = R_tryEval(VECTOR_ELT(exprs, i), R_GlobalEnv, &hasError);
+		if (hasError)
+		{
+			fprintf(stderr, "Evaluation failed: %s\n", code);
+			exit(1);
+		}
+	}
+
+	UNPROTECT(2);
+	return result;
+}
+
+static external_ptr findEntryPoint(const char* name)
+{
+	external_ptr fn = (external_ptr)R_FindSymbol(name, "sharper", NULL);
+	if (fn == NULL)
+	{
+		fprintf(stderr, "Entry point %s not found in sharper\n", name);
+		exit(1);
+	}
+	return fn;
+}
+
+// Preserves a value as soon as it is allocated, so the next allocations can't collect it
+static SEXP keep(SEXP x)
+{
+	R_PreserveObject(x);
+	return x;
+}
+
+// Builds the .External arguments, the first one is the entry point name. The arguments have to be kept.
+static SEXP makeArgs(const char* name, const std::vector<SEXP>& args)
+{
+	SEXP p = keep(Rf_allocList((int)args.size() + 1));
+	SETCAR(p, Rf_mkString(name));
+	SEXP it = CDR(p);
+	for (size_t i = 0; i < args.size(); i++, it = CDR(it))
+		SETCAR(it, args[i]);
+	return p;
+}
+
+static void runLoop(void* data)
+{
+	BenchLoop* loop = (BenchLoop*)data;
+	bench_clock::time_point start = bench_clock::now();
+	for (long i = 0; i < loop->iterations; i++)
+		loop->fn(loop->args);
+	loop->elapsedNs = elapsedSince(start);
+}
+
+static void addResult(const char* group, const std::string& name, double size, long iterations, double elapsedNs)
+{
+	BenchResult result = { group, name, size, iterations, elapsedNs };
+	results.push_back(result);
+	printf("%-12s %-36s %12.0f %10ld %14.1f ns/call %14.0f calls/s\n",
+		group, name.c_str(), size, iterations, result.nsPerCall(), result.callsPerSecond());
+	fflush(stdout);
+}
+
+// Runs the loop within a top level context, so an R error stops only the current measure
+static bool measure(const char* group, const std::string& name, double size, external_ptr fn, SEXP args, long iterations)
+{
+	BenchLoop warmUp = { fn, args, iterations / 10 > 0 ? iterations / 10 : 1, 0 };
+	BenchLoop loop = { fn, args, iterations, 0 };
+	if (!R_ToplevelExec(runLoop, &warmUp) || !R_ToplevelExec(runLoop, &loop))
+	{
+		fprintf(stderr, "%s %s failed\n", group, name.c_str());
+		return false;
+	}
+
+	addResult(group, name, size, loop.iterations, loop.elapsedNs);
+	return true;
+}
+
+static void benchCalls(const BenchOptions& options)
+{
+	external_ptr callStatic = findEntryPoint("rCallStaticMethod");
+	external_ptr call = findEntryPoint("rCallMethod");
+	SEXP instance = evalR("netNew('AssemblyForTests.BenchmarkClass')");
+	R_PreserveObject(instance);
+
+	for (int count = 0; count <= 8; count++)
+	{
+		std::vector<SEXP> staticArgs = { keep(Rf_mkString("AssemblyForTests.BenchmarkClass")), keep(Rf_mkString("StaticArguments")) };
+		std::vector<SEXP> args = { instance, keep(Rf_mkString("Arguments")) };
+		for (int i = 0; i < count; i++)
+		{
+			staticArgs.push_back(keep(Rf_ScalarReal(i + 1.0)));
+			args.push_back(keep(Rf_ScalarReal(i + 1.0)));
+		}
+
+		measure("call", "rCallStaticMethod/" + std::to_string(count) + " args", count, callStatic, makeArgs("rCallStaticMethod", staticArgs), options.iterations);
+		measure("call", "rCallMethod/" + std::to_string(count) + " args", count, call, makeArgs("rCallMethod", args), options.iterations);
+	}
+}
+
+static void benchProperties(const BenchOptions& options)
+{
+	SEXP instance = evalR("netNew('AssemblyForTests.BenchmarkClass')");
+	R_PreserveObject(instance);
+
+	measure("property", "rGetProperty", 1, findEntryPoint("rGetProperty"),
+		makeArgs("rGetProperty", { instance, keep(Rf_mkString("Value")) }), options.iterations);
+	measure("property", "rSetProperty", 1, findEntryPoint("rSetProperty"),
+		makeArgs("rSetProperty", { instance, keep(Rf_mkString("Value")), keep(Rf_ScalarReal(1.5)) }), options.iterations);
+	measure("property", "rGetStaticProperty", 1, findEntryPoint("rGetStaticProperty"),
+		makeArgs("rGetStaticProperty", { keep(Rf_mkString("AssemblyForTests.StaticClass")), keep(Rf_mkString("DoubleProperty")) }), options.iterations);
+	measure("property", "rSetStaticProperty", 1, findEntryPoint("rSetStaticProperty"),
+		makeArgs("rSetStaticProperty", { keep(Rf_mkString("AssemblyForTests.StaticClass")), keep(Rf_mkString("DoubleProperty")), keep(Rf_ScalarReal(1.5)) }), options.iterations);
+}
+
+static void benchObjects(const BenchOptions& options)
+{
+	external_ptr create = findEntryPoint("rCreateObject");
+	SEXP args = makeArgs("rCreateObject", { keep(Rf_mkString("AssemblyForTests.BenchmarkClass")) });
+
+	// The finalizers only queue the handles of the collected objects, the next call releases them by batch
+	BenchLoop flush = { findEntryPoint("rCallStaticMethod"),
+		makeArgs("rCallStaticMethod", { keep(Rf_mkString("AssemblyForTests.StaticClass")), keep(Rf_mkString("Nop")) }), 1, 0 };
+
+	// The created objects aren't kept, so a full collection runs all their finalizers.
+	// A collection can also run during the creation loop, but its finalizers only run at the next full collection.
+	R_gc();
+	if (!R_ToplevelExec(runLoop, &flush))
+	{
+		fprintf(stderr, "object Nop failed\n");
+		return;
+	}
+
+	BenchLoop loop = { create, args, options.iterations, 0 };
+	if (!R_ToplevelExec(runLoop, &loop))
+	{
+		fprintf(stderr, "object rCreateObject failed\n");
+		return;
+	}
+	addResult("object", "rCreateObject", 1, loop.iterations, loop.elapsedNs);
+
+	bench_clock::time_point start = bench_clock::now();
+	R_gc();
+	if (!R_ToplevelExec(runLoop, &flush))
+	{
+		fprintf(stderr, "object finalizer release failed\n");
+		return;
+	}
+	addResult("object", "finalizer release", 1, loop.iterations, elapsedSince(start));
+}
+
+static void benchVectors(const BenchOptions& options)
+{
+	// Round trips through StaticClass.ReturnsNativeType, the vector is converted to .Net then back to R
+	static const char* types[][2] = {
+		{ "integer", "seq_len(%.0f)" },
+		{ "numeric", "as.numeric(seq_len(%.0f))" },
+		{ "logical", "rep_len(c(TRUE, FALSE), %.0f)" },
+		{ "character", "as.character(seq_len(%.0f))" },
+		{ "POSIXct", "as.POSIXct(seq_len(%.0f), origin = '1970-01-01', tz = 'UTC')" },
+		{ "difftime", "as.difftime(as.numeric(seq_len(%.0f)), units = 'secs')" }
+	};
+	external_ptr callStatic = findEntryPoint("rCallStaticMethod");
+	char code[256];
+
+	for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++)
+	{
+		for (double size = options.minSize; size <= options.maxSize; size *= 10)
+		{
+			snprintf(code, sizeof(code), types[t][1], size);
+			SEXP vector = keep(evalR(code));
+			SEXP args = makeArgs("rCallStaticMethod", { keep(Rf_mkString("AssemblyForTests.StaticClass")), keep(Rf_mkString("ReturnsNativeType")), vector });
+
+			// Keeps about 1e7 converted elements per measure
+			long iterations = (long)(1e7 / size);
+			measure("vector", std::string("round trip/") + types[t][0], size, callStatic, args, iterations > 0 ? iterations : 1);
+
+			// Frees the vector before the next size
+			for (SEXP it = CDR(args); it != R_NilValue; it = CDR(it))
+				R_ReleaseObject(CAR(it));
+			R_ReleaseObject(args);
+			R_gc();
+		}
+	}
+}
+
+static void writeCsv(const char* file)
+{
+	FILE* f = fopen(file, "w");
+	if (f == NULL)
+	{
+		fprintf(stderr, "Unable to write %s\n", file);
+		return;
+	}
+
+	fprintf(f, "group,name,size,iterations,elapsed_ns,ns_per_call,calls_per_second,elements_per_second\n");
+	for (const BenchResult& r : results)
+		fprintf(f, "%s,%s,%.0f,%ld,%.0f,%.3f,%.3f,%.3f\n",
+			r.group.c_str(), r.name.c_str(), r.size, r.iterations, r.elapsedNs, r.nsPerCall(), r.callsPerSecond(), r.elementsPerSecond());
+	fclose(f);
+}
+
+static void writeJson(const char* file)
+{
+	FILE* f = fopen(file, "w");
+	if (f == NULL)
+	{
+		fprintf(stderr, "Unable to write %s\n", file);
+		return;
+	}
+
+	fprintf(f, "[\n");
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const BenchResult& r = results[i];
+		fprintf(f, "  { \"group\": \"%s\", \"name\": \"%s\", \"size\": %.0f, \"iterations\": %ld, \"elapsed_ns\": %.0f, "
+			"\"ns_per_call\": %.3f, \"calls_per_second\": %.3f, \"elements_per_second\": %.3f }%s\n",
+			r.group.c_str(), r.name.c_str(), r.size, r.iterations, r.elapsedNs,
+			r.nsPerCall(), r.callsPerSecond(), r.elementsPerSecond(), i + 1 < results.size() ? "," : "");
+	}
+	fprintf(f, "]\n");
+	fclose(f);
+}
+
+static BenchOptions parseOptions(int argc, char** argv)
+{
+	BenchOptions options;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--iterations") == 0) options.iterations = atol(argv[i + 1]);
+		else if (strcmp(argv[i], "--min-size") == 0) options.minSize = atof(argv[i + 1]);
+		else if (strcmp(argv[i], "--max-size") == 0) options.maxSize = atof(argv[i + 1]);
+		else if (strcmp(argv[i], "--csv") == 0) options.csvFile = argv[i + 1];
+		else if (strcmp(argv[i], "--json") == 0) options.jsonFile = argv[i + 1];
+		else
+		{
+			fprintf(stderr, "Unknown option %s\n", argv[i]);
+			exit(1);
+		}
+	}
+	return options;
+}
+
+int main(int argc, char** argv)
+{
+	BenchOptions options = parseOptions(argc, argv);
+
+	char* rArgs[] = { (char*)"R", (char*)"--vanilla", (char*)"--silent", (char*)"--no-save" };
+	Rf_initEmbeddedR(sizeof(rArgs) / sizeof(rArgs[0]), rArgs);
+
+	evalR("library(sharper); netLoadAssembly(file.path(path.package('sharper'), 'tests', 'AssemblyForTests.dll'))");
+	printf("Runtime: %s\n", CHAR(STRING_ELT(evalR("netCall(netGetStatic('System.Environment', 'Version'), 'ToString')"), 0)));
+
+	benchCalls(options);
+	benchProperties(options);
+	benchObjects(options);
+	benchVectors(options);
+
+	if (options.csvFile != NULL) writeCsv(options.csvFile);
+	if (options.jsonFile != NULL) writeJson(options.jsonFile);
+
+	Rf_endEmbeddedR(0);
+	return 0;
+}
@@ -0,0 +1,38 @@
+﻿namespace AssemblyForTests
+{
+    /// <summary>
+    /// Methods and properties used by the benchmarks to measure the call path cost from 0 to 8 arguments.
+    /// </summary>
+    public class BenchmarkClass
+    {
+        public double Value { get; set; }
+
+        #region Static methods
+
+        public static double StaticArguments() => 0;
+        public static double StaticArguments(double x1) => x1;
+        public static double StaticArguments(double x1, double x2) => x1 + x2;
+        public static double StaticArguments(double x1, double x2, double x3) => x1 + x2 + x3;
+        public static double StaticArguments(double x1, double x2, double x3, double x4) => x1 + x2 + x3 + x4;
+        public static double StaticArguments(double x1, double x2, double x3, double x4, double x5) => x1 + x2 + x3 + x4 + x5;
+        public static double StaticArguments(double x1, double x2, double x3, double x4, double x5, double x6) => x1 + x2 + x3 + x4 + x5 + x6;
+        public static double StaticArguments(double x1, double x2, double x3, double x4, double x5, double x6, double x7) => x1 + x2 + x3 + x4 + x5 + x6 + x7;
+        public static double StaticArguments(double x1, double x2, double x3, double x4, double x5, double x6, double x7, double x8) => x1 + x2 + x3 + x4 + x5 + x6 + x7 + x8;
+
+        #endregion
+
+        #region Instance methods
+
+        public double Arguments() => Value;
+        public double Arguments(double x1) => Value + x1;
+        public double Arguments(double x1, double x2) => Value + x1 + x2;
+        public double Arguments(double x1, double x2, double x3) => Value + x1 + x2 + x3;
+        public double Arguments(double x1, double x2, double x3, double x4) => Value + x1 + x2 + x3 + x4;
+        public double Arguments(double x1, double x2, double x3, double x4, double x5) => Value + x1 + x2 + x3 + x4 + x5;
+        public double Arguments(double x1, double x2, double x3, double x4, double x5, double x6) => Value + x1 + x2 + x3 + x4 + x5 + x6;
+        public double Arguments(double x1, double x2, double x3, double x4, double x5, double x6, double x7) => Value + x1 + x2 + x3 + x4 + x5 + x6 + x7;
+        public double Arguments(double x1, double x2, double x3, double x4, double x5, double x6, double x7, double x8) => Value + x1 + x2 + x3 + x4 + x5 + x6 + x7 + x8;
+
+        #endregion
+    }
+}
@@ -106,4 +106,13 @@
     {
         public int Id { get; set; }
     }
+
+    public class NullableOverloads
+    {
+        public string Describe(int value) => "int";
+
+        public string Describe(int? value) => value.HasValue ? "int?" : "null";
+
+        public string Name(string name) => name;
+    }
 }
@@ -0,0 +1,8 @@
+﻿namespace AssemblyForTests
+{
+    public enum Side
+    {
+        Buy,
+        Sell
+    }
+}
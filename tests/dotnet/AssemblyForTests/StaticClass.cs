@@ -1,4 +1,10 @@
 ﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Reflection;
+using System.Threading.Tasks;
+using Apache.Arrow;
+using Sharper.Converters;
 
 namespace AssemblyForTests
 {
@@ -83,6 +89,8 @@ namespace AssemblyForTests
         public static TimeSpan[] ReturnsNativeType(TimeSpan[] x) => x;
         public static TimeSpan[,] ReturnsNativeType(TimeSpan[,] x) => x;
 
+        public static int IntegerOrDefault(int x) => x;
+
         public static DefaultCtorData Clone(DefaultCtorData data) => data?.Clone();
 
         public static double[,] Clone(DefaultCtorData data, double[,] matrix, out DefaultCtorData clone)
@@ -105,6 +113,327 @@ namespace AssemblyForTests
 
         #endregion
 
+        #region Method with span arguments
+
+        public static double Sum(ReadOnlySpan<double> x)
+        {
+            var sum = 0.0;
+            for (var i = 0; i < x.Length; i++)
+                sum += x[i];
+            return sum;
+        }
+
+        public static int Sum(ReadOnlySpan<int> x)
+        {
+            var sum = 0;
+            for (var i = 0; i < x.Length; i++)
+                sum += x[i];
+            return sum;
+        }
+
+        public static double SumArray(double[] x) => Sum(x);
+
+        public static RVector<double> Scale(ReadOnlySpan<double> x, double factor)
+        {
+            var result = RAllocator.Numeric(x.Length);
+            var span = result.AsSpan();
+            for (var i = 0; i < x.Length; i++)
+                span[i] = x[i] * factor;
+            return result;
+        }
+
+        public static void ScaleInPlace(Span<double> x, double factor)
+        {
+            for (var i = 0; i < x.Length; i++)
+                x[i] *= factor;
+        }
+
+        public static void Fill(RVector<double> x, double value)
+        {
+            for (var i = 0; i < x.Length; i++)
+                x[i] = value;
+        }
+
+        public static int Length(ReadOnlyMemory<double> x) => x.Length;
+
+        #endregion
+
+        #region Method with results allocated by R
+
+        public static RVector<double> NumericSequence(int length)
+        {
+            var vector = RAllocator.Numeric(length);
+            var span = vector.AsSpan();
+            for (var i = 0; i < span.Length; i++)
+                span[i] = i * 0.5;
+            return vector;
+        }
+
+        public static RVector<int> IntegerSequence(int length)
+        {
+            var vector = RAllocator.Integer(length);
+            for (var i = 0; i < vector.Length; i++)
+                vector[i] = i;
+            return vector;
+        }
+
+        public static RVector<int> Alternate(int length)
+        {
+            var vector = RAllocator.Logical(length);
+            for (var i = 0; i < vector.Length; i++)
+                vector[i] = i % 2;
+            return vector;
+        }
+
+        public static RVector<double> Same(RVector<double> x) => x;
+
+        #endregion
+
+        #region Method with matrix arguments
+
+        public static double SumMatrix(RMatrix<double> x)
+        {
+            var sum = 0.0;
+            var span = x.AsReadOnlySpan();
+            for (var i = 0; i < span.Length; i++)
+                sum += span[i];
+            return sum;
+        }
+
+        public static int SumMatrix(RMatrix<int> x)
+        {
+            var sum = 0;
+            for (var j = 0; j < x.ColumnCount; j++)
+            for (var i = 0; i < x.RowCount; i++)
+                sum += x[i, j];
+            return sum;
+        }
+
+        public static void ScaleMatrix(RMatrix<double> x, double factor)
+        {
+            var span = x.AsSpan();
+            for (var i = 0; i < span.Length; i++)
+                span[i] *= factor;
+        }
+
+        public static RMatrix<double> SameMatrix(RMatrix<double> x) => x;
+
+        /// <summary>
+        /// Computes the covariance of the columns, into a matrix allocated by R.
+        /// </summary>
+        public static RMatrix<double> Covariance(RMatrix<double> x)
+        {
+            var result = RAllocator.NumericMatrix(x.ColumnCount, x.ColumnCount);
+            var means = new double[x.ColumnCount];
+            for (var j = 0; j < x.ColumnCount; j++)
+            {
+                var column = x.ReadOnlyColumn(j);
+                for (var i = 0; i < column.Length; i++)
+                    means[j] += column[i];
+                means[j] /= column.Length;
+            }
+
+            for (var j = 0; j < x.ColumnCount; j++)
+            for (var k = 0; k <= j; k++)
+            {
+                var a = x.ReadOnlyColumn(j);
+                var b = x.ReadOnlyColumn(k);
+                var sum = 0.0;
+                for (var i = 0; i < a.Length; i++)
+                    sum += (a[i] - means[j]) * (b[i] - means[k]);
+                result[j, k] = result[k, j] = sum / (a.Length - 1);
+            }
+            return result;
+        }
+
+        public static double[,] TransposeArray(double[,] x)
+        {
+            var result = new double[x.GetLength(1), x.GetLength(0)];
+            for (var i = 0; i < x.GetLength(0); i++)
+            for (var j = 0; j < x.GetLength(1); j++)
+                result[j, i] = x[i, j];
+            return result;
+        }
+
+        public static double SumArray(double[,] x)
+        {
+            var sum = 0.0;
+            foreach (var value in x)
+                sum += value;
+            return sum;
+        }
+
+        public static double[,] CreateArray(int rowCount, int columnCount) => new double[rowCount, columnCount];
+
+        #endregion
+
+        #region Method called by batch
+
+        public static double Add(double x, double y) => x + y;
+
+        public static string Concat(string x, int count) => x + count;
+
+        #endregion
+
+        #region Method called asynchronously
+
+        public static double SlowAdd(double x, double y, int delay)
+        {
+            System.Threading.Thread.Sleep(delay);
+            return x + y;
+        }
+
+        public static void SlowThrow(int delay)
+        {
+            System.Threading.Thread.Sleep(delay);
+            throw new InvalidOperationException("Slow failure");
+        }
+
+        public static async Task<double> DelayedAdd(double x, double y, int delay)
+        {
+            await Task.Delay(delay);
+            return x + y;
+        }
+
+        public static async Task DelayedNop(int delay)
+        {
+            await Task.Delay(delay);
+        }
+
+        #endregion
+
+        #region Method with data.frame arguments
+
+        public static int CountRows(RDataFrame frame) => frame.RowCount;
+
+        public static RDataFrame EchoFrame(RDataFrame frame) => frame;
+
+        public static string[] ColumnTypes(RDataFrame frame)
+            => Enumerable.Range(0, frame.ColumnCount).Select(p => frame[p].GetType().Name).ToArray();
+
+        public static RDataFrame CreateFrame(int rows)
+        {
+            var origin = new DateTime(2020, 1, 1, 0, 0, 0, DateTimeKind.Utc);
+            return new RDataFrame(rows)
+                .Add("id", Enumerable.Range(1, rows).ToArray())
+                .Add("value", Enumerable.Range(0, rows).Select(p => p % 3 == 2 ? RDataFrame.NaReal : p * 0.5).ToArray())
+                .Add("flag", Enumerable.Range(0, rows).Select(p => p % 3 == 2 ? (bool?)null : p % 2 == 0).ToArray())
+                .Add("label", Enumerable.Range(0, rows).Select(p => p % 3 == 2 ? null : "row" + p).ToArray())
+                .Add("time", Enumerable.Range(0, rows).Select(p => p % 3 == 2 ? (DateTime?)null : origin.AddHours(p)).ToArray());
+        }
+
+        public static double SumFrame(RDataFrame frame)
+        {
+            var sum = 0.0;
+            for (var i = 0; i < frame.ColumnCount; i++)
+            {
+                if (frame[i] is double[] column)
+                    sum += column.Sum();
+            }
+            return sum;
+        }
+
+        public static double SumColumns(Dictionary<string, double[]> columns) => columns.Values.Sum(p => p.Sum());
+
+        public static RDataFrame CreateNumericFrame(int rows, int columns)
+        {
+            var frame = new RDataFrame(rows);
+            for (var i = 0; i < columns; i++)
+                frame.Add("V" + (i + 1), new double[rows]);
+            return frame;
+        }
+
+        public static Dictionary<string, double[]> CreateNumericColumns(int rows, int columns)
+            => Enumerable.Range(1, columns).ToDictionary(p => "V" + p, p => new double[rows]);
+
+        #endregion
+
+        #region Method with factor and character arguments
+
+        public static RFactor EchoFactor(RFactor factor) => factor;
+
+        public static int[] FactorCodes(RFactor factor) => factor.Codes;
+
+        public static string[] FactorLevels(RFactor factor) => factor.Levels;
+
+        public static Side[] EchoSides(Side[] sides) => sides;
+
+        public static string SideName(Side side) => side.ToString();
+
+        public static string[] EchoStrings(string[] values) => values;
+
+        public static int CountStrings(string[] values) => values.Length;
+
+        public static int CountFactor(RFactor factor) => factor.Length;
+
+        public static string FactorOverload(int[] codes) => "codes";
+
+        public static string FactorOverload(string[] labels) => "labels";
+
+        public static int FactorAsArray(Array values) => (int)values.GetValue(0);
+
+        /// <summary>
+        /// Gets if the equal values are the same string instance.
+        /// </summary>
+        public static bool AreInterned(string[] values)
+        {
+            var instances = new Dictionary<string, string>();
+            foreach (var value in values.Where(p => p != null))
+            {
+                if (!instances.TryGetValue(value, out var instance))
+                    instances.Add(value, value);
+                else if (!ReferenceEquals(instance, value))
+                    return false;
+            }
+            return true;
+        }
+
+        public static string[] CreateSymbols(int rows, int distinct)
+        {
+            var symbols = Enumerable.Range(0, distinct).Select(p => "SYM" + p).ToArray();
+            return Enumerable.Range(0, rows).Select(p => symbols[p % distinct]).ToArray();
+        }
+
+        public static RFactor CreateSymbolsFactor(int rows, int distinct)
+            => new RFactor(Enumerable.Range(0, rows).Select(p => p % distinct).ToArray(), Enumerable.Range(0, distinct).Select(p => "SYM" + p).ToArray());
+
+        #endregion
+
+        #region Method with arrow arguments
+
+        public static int CountBatchRows(RecordBatch batch) => batch.Length;
+
+        public static double SumBatchColumn(RecordBatch batch, string column)
+        {
+            var array = (DoubleArray)batch.Column(batch.Schema.GetFieldIndex(column));
+            var sum = 0.0;
+            var values = array.Values;
+            for (var i = 0; i < values.Length; i++)
+                sum += values[i];
+            return sum;
+        }
+
+        public static RecordBatch CreateBatch(int rows)
+        {
+            return new RecordBatch.Builder()
+                .Append("id", false, p => p.Int32(array => array.AppendRange(Enumerable.Range(1, rows))))
+                .Append("value", false, p => p.Double(array => array.AppendRange(Enumerable.Range(0, rows).Select(x => x * 0.5))))
+                .Build();
+        }
+
+        #endregion
+
+        #region Benchmark helpers
+
+        // Not part of netstandard2.0, but available on the .Net Core runtime hosting the tests
+        private static readonly MethodInfo allocatedBytes = typeof(GC).GetMethod("GetAllocatedBytesForCurrentThread", Type.EmptyTypes);
+
+        public static double AllocatedBytes() => allocatedBytes != null ? Convert.ToDouble(allocatedBytes.Invoke(null, null)) : double.NaN;
+
+        public static void Nop() { }
+
+        #endregion
+
         #region Method with out arguments
 
         public static bool TryGetValue(out double value)
@@ -0,0 +1,124 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Threading;
+using System.Threading.Tasks;
+using NUnit.Framework;
+using Sharper.Loggers;
+
+namespace Sharper.Tests
+{
+    [TestFixture]
+    public class AsyncLoggerTests
+    {
+        [Test]
+        public void TestWriteInOrder()
+        {
+            var sink = new MemorySink();
+            var logger = new AsyncLogger("Test", sink) { Level = LogLevel.Debug };
+
+            for (var i = 0; i < 100; i++)
+                logger.DebugFormat("Message {0}", i);
+            logger.Flush();
+
+            Assert.AreEqual(100, sink.Messages.Count);
+            for (var i = 0; i < 100; i++)
+                Assert.AreEqual($"Message {i}", sink.Messages[i]);
+        }
+
+        [Test]
+        public void TestLevel()
+        {
+            var sink = new MemorySink();
+            var logger = new AsyncLogger("Test", sink) { Level = LogLevel.Warn };
+
+            logger.Debug("Debug");
+            logger.InfoFormat("Info {0}", 1);
+            logger.Warn("Warn");
+            logger.ErrorFormat("Error {0} {1}", 1, 2);
+            logger.Flush();
+
+            CollectionAssert.AreEqual(new[] { "Warn", "Error 1 2" }, sink.Messages);
+            CollectionAssert.AreEqual(new[] { LogLevel.Warn, LogLevel.Error }, sink.Levels);
+
+            logger.Level = LogLevel.Off;
+            logger.Error("Error");
+            logger.Flush();
+            Assert.AreEqual(2, sink.Messages.Count);
+        }
+
+        [Test]
+        public void TestConcurrentProducers()
+        {
+            var sink = new MemorySink();
+            var logger = new AsyncLogger("Test", sink, 1 << 16);
+
+            Parallel.For(0, 8, t =>
+            {
+                for (var i = 0; i < 1000; i++)
+                    logger.InfoFormat("{0}-{1}", t, i);
+            });
+            logger.Flush();
+
+            Assert.AreEqual(8000, sink.Messages.Count);
+            Assert.AreEqual(0, logger.Dropped);
+            Assert.AreEqual(8000, new HashSet<string>(sink.Messages).Count);
+        }
+
+        [Test]
+        public void TestDropWhenFull()
+        {
+            var sink = new MemorySink { Block = new ManualResetEventSlim(false) };
+            var logger = new AsyncLogger("Test", sink, 4);
+
+            // The consumer takes the first message then waits in the sink
+            logger.Error("First");
+            sink.Blocked.Wait(TimeSpan.FromSeconds(5)).CheckIsTrue();
+
+            for (var i = 0; i < 10; i++)
+                logger.Info($"Message {i}");
+            Assert.AreEqual(6, logger.Dropped);
+
+            sink.Block.Set();
+            logger.Flush();
+
+            Assert.AreEqual(6, sink.Messages.Count);
+            Assert.AreEqual("First", sink.Messages[0]);
+            Assert.AreEqual("Message 3", sink.Messages[4]);
+            StringAssert.StartsWith("6 log messages have been dropped", sink.Messages[5]);
+        }
+
+        [Test]
+        public void TestLogManager()
+        {
+            var logger = LogManager.CreateLogger("Test", "debug", LogManager.ConsoleSink);
+            Assert.AreEqual(LogLevel.Debug, logger.Level);
+
+            logger = LogManager.CreateLogger("Test", null, LogManager.NoSink);
+            Assert.AreEqual(LogLevel.Off, logger.Level);
+
+            Assert.Throws<ArgumentException>(() => LogManager.CreateLogger("Test", "Verbose", null));
+            Assert.Throws<ArgumentException>(() => LogManager.CreateLogger("Test", null, "R"));
+        }
+
+        private class MemorySink : ILogSink
+        {
+            public List<string> Messages { get; } = new List<string>();
+            public List<LogLevel> Levels { get; } = new List<LogLevel>();
+            public ManualResetEventSlim Block { get; set; }
+            public ManualResetEventSlim Blocked { get; } = new ManualResetEventSlim(false);
+
+            public void Write(DateTime time, LogLevel level, string message)
+            {
+                Blocked.Set();
+                Block?.Wait();
+                lock (Messages)
+                {
+                    Messages.Add(message);
+                    Levels.Add(level);
+                }
+            }
+
+            public void Flush() { }
+        }
+    }
+}
@@ -7,6 +7,9 @@ namespace Sharper.Tests
         public static void CheckIsTrue(this bool value, string message = null)
             => Assert.IsTrue(value, message);
 
+        public static void CheckIsFalse(this bool value, string message = null)
+            => Assert.IsFalse(value, message);
+
         public static T CheckIsNull<T>(this T value, string message = null)
         {
             Assert.IsNull(value, message);
@@ -27,7 +27,7 @@ namespace Sharper.Tests
             const string methodName = "SameMethodName";
             const BindingFlags flags = BindingFlags.Public | BindingFlags.Static;
 
-            ClrProxy.CallStaticMethod(typeName, methodName, null, 0, out _, out _);
+            CallStaticMethod(typeName, methodName, null, out _, out _);
             
             typeName.TryGetType(out var type, out var errorMessage).CheckIsTrue();
             errorMessage.CheckIsNull();
@@ -66,47 +66,47 @@ namespace Sharper.Tests
             const string typeName = "AssemblyForTests.StaticClass";
             const string methodName = "SameMethodName";
 
-            ClrProxy.CallStaticMethod(typeName, methodName, null, 0, out _, out _);
+            CallStaticMethod(typeName, methodName, null, out _, out _);
 
             SymbolicExpression sexp = engine.CreateInteger(1);
             var arguments = new[] { (long)sexp.DangerousGetHandle() };
-            ClrProxy.CallStaticMethod(typeName, methodName, arguments, arguments.Length, out _, out _);
+            CallStaticMethod(typeName, methodName, arguments, out _, out _);
 
             sexp = engine.CreateNumeric(1.0);
             arguments = new[] { (long)sexp.DangerousGetHandle() };
-            ClrProxy.CallStaticMethod(typeName, methodName, arguments, arguments.Length, out _, out _);
+            CallStaticMethod(typeName, methodName, arguments, out _, out _);
 
             sexp = REngineExtension.CreateIntegerVector(engine, new[] {1, 2, 3});
             arguments = new[] { (long)sexp.DangerousGetHandle() };
-            ClrProxy.CallStaticMethod(typeName, methodName, arguments, arguments.Length, out _, out _);
+            CallStaticMethod(typeName, methodName, arguments, out _, out _);
 
             sexp = REngineExtension.CreateNumericVector(engine, new[] { 1.0, 2.0, 3.0 });
             arguments = new[] { (long)sexp.DangerousGetHandle() };
-            ClrProxy.CallStaticMethod(typeName, methodName, arguments, arguments.Length, out _, out _);
+            CallStaticMethod(typeName, methodName, arguments, out _, out _);
 
             sexp = engine.CreateNumeric(1.0); 
             SymbolicExpression sexp2 = engine.CreateInteger(1);
             arguments = new[] { (long)sexp.DangerousGetHandle(), (long)sexp2.DangerousGetHandle() };
-            ClrProxy.CallStaticMethod(typeName, methodName, arguments, arguments.Length, out _, out _);
+            CallStaticMethod(typeName, methodName, arguments, out _, out _);
 
             sexp = REngineExtension.CreateNumericVector(engine, new[] { 1.0, 2.0, 3.0 }); 
             sexp2 = REngineExtension.CreateIntegerVector(engine, new[] { 1, 2, 3 });
             arguments = new[] { (long)sexp.DangerousGetHandle(), (long)sexp2.DangerousGetHandle() };
-            ClrProxy.CallStaticMethod(typeName, methodName, arguments, arguments.Length, out _, out _);
+            CallStaticMethod(typeName, methodName, arguments, out _, out _);
 
             sexp = engine.CreateInteger(1);
             sexp2 = REngineExtension.CreateNumericVector(engine, new[] { 1.0, 2.0, 3.0 });
             arguments = new[] { (long)sexp2.DangerousGetHandle(), (long)sexp.DangerousGetHandle() };
-            ClrProxy.CallStaticMethod(typeName, methodName, arguments, arguments.Length, out _, out _);
+            CallStaticMethod(typeName, methodName, arguments, out _, out _);
 
             sexp = REngineExtension.CreateIntegerVector(engine, new[] { 1, 2, 3 });
             sexp2 = engine.CreateNumeric(1.0);
             arguments = new[] { (long)sexp2.DangerousGetHandle(), (long)sexp.DangerousGetHandle() };
-            ClrProxy.CallStaticMethod(typeName, methodName, arguments, arguments.Length, out _, out _);
+            CallStaticMethod(typeName, methodName, arguments, out _, out _);
 
-            Assert.IsTrue(ClrProxy.CreateObject("AssemblyForTests.DefaultCtorData", null, 0, out var externalPtr));
+            Assert.IsTrue(CreateObject("AssemblyForTests.DefaultCtorData", null, out var externalPtr));
             arguments = new[] {externalPtr};
-            ClrProxy.CallStaticMethod(typeName, methodName, arguments, arguments.Length, out _, out _);
+            CallStaticMethod(typeName, methodName, arguments, out _, out _);
         }
 
         [Test]
@@ -115,12 +115,11 @@ namespace Sharper.Tests
             var engine = REngine.GetInstance();
             ClrProxy.LoadAssembly(PATH);
 
-            Assert.IsTrue(ClrProxy.CreateObject("AssemblyForTests.DefaultCtorData", null, 0, out var externalPtr));
+            Assert.IsTrue(CreateObject("AssemblyForTests.DefaultCtorData", null, out var externalPtr));
 
-            ClrProxy.CallMethod(externalPtr, "ToString", null, 0, out var results, out var resultsSize);
+            CallMethod(externalPtr, "ToString", null, out var results, out var resultsSize);
             Assert.IsNotNull(results);
             Assert.AreEqual(1, resultsSize);
-            Assert.AreEqual(1, results.Length);
 
             var sexp = engine.CreateFromNativeSexp(new IntPtr(results[0]));
             Assert.AreEqual("AssemblyForTests.DefaultCtorData", sexp.AsCharacter().ToArray()[0]);
@@ -132,7 +131,7 @@ namespace Sharper.Tests
             var engine = REngine.GetInstance();
             ClrProxy.LoadAssembly(PATH);
 
-            Assert.IsTrue(ClrProxy.CreateObject("AssemblyForTests.DefaultCtorData", null, 0, out var externalPtr));
+            Assert.IsTrue(CreateObject("AssemblyForTests.DefaultCtorData", null, out var externalPtr));
 
             var sexp = engine.CreateCharacter("Test");
             ClrProxy.SetProperty(externalPtr, "Name", sexp.DangerousGetHandle().ToInt64());
@@ -152,14 +151,14 @@ namespace Sharper.Tests
 
             var sexp = engine.CreateNumeric(0.0);
             var arguments = new[] { (long)sexp.DangerousGetHandle() };
-            Assert.IsTrue(ClrProxy.CallStaticMethod(typeName, "TryGetValue", arguments, arguments.Length, out var results, out var resultsSize));
+            Assert.IsTrue(CallStaticMethod(typeName, "TryGetValue", arguments, out var results, out var resultsSize));
             Assert.AreEqual(2, resultsSize);
             Assert.IsTrue(engine.CreateFromNativeSexp(new IntPtr(results[0])).AsLogical()[0]);
             Assert.AreEqual(12.4, engine.CreateFromNativeSexp(new IntPtr(results[1])).AsNumeric()[0]);
 
-            Assert.IsTrue(ClrProxy.CreateObject("AssemblyForTests.DefaultCtorData", null, 0, out var ptr));
+            Assert.IsTrue(CreateObject("AssemblyForTests.DefaultCtorData", null, out var ptr));
             arguments = new[] { ptr };
-            Assert.IsTrue(ClrProxy.CallStaticMethod(typeName, "TryGetObject", arguments, arguments.Length, out results, out resultsSize));
+            Assert.IsTrue(CallStaticMethod(typeName, "TryGetObject", arguments, out results, out resultsSize));
             Assert.AreEqual(2, resultsSize);
             Assert.IsTrue(engine.CreateFromNativeSexp(new IntPtr(results[0])).AsLogical()[0]);
 
@@ -177,14 +176,14 @@ namespace Sharper.Tests
 
             var sexp = engine.CreateNumeric(1.0);
             var arguments = new[] { (long)sexp.DangerousGetHandle() };
-            Assert.IsTrue(ClrProxy.CallStaticMethod(typeName, "UpdateValue", arguments, arguments.Length, out var results, out var resultsSize));
+            Assert.IsTrue(CallStaticMethod(typeName, "UpdateValue", arguments, out var results, out var resultsSize));
             Assert.AreEqual(2, resultsSize);
             Assert.AreEqual(engine.NilValue, engine.CreateFromNativeSexp(new IntPtr(results[0])));
             Assert.AreEqual(2, engine.CreateFromNativeSexp(new IntPtr(results[1])).AsNumeric()[0]);
 
-            Assert.IsTrue(ClrProxy.CreateObject("AssemblyForTests.DefaultCtorData", null, 0, out var ptr));
+            Assert.IsTrue(CreateObject("AssemblyForTests.DefaultCtorData", null, out var ptr));
             arguments = new[] { ptr };
-            Assert.IsTrue(ClrProxy.CallStaticMethod(typeName, "UpdateObject", arguments, arguments.Length, out results, out resultsSize));
+            Assert.IsTrue(CallStaticMethod(typeName, "UpdateObject", arguments, out results, out resultsSize));
             Assert.AreEqual(2, resultsSize);
             Assert.AreEqual(engine.NilValue, engine.CreateFromNativeSexp(new IntPtr(results[0])));
             Assert.IsTrue(ClrProxy.GetProperty(results[1], "Name", out var namePtr));
@@ -252,6 +251,53 @@ namespace Sharper.Tests
         }
 
 
+        [Test]
+        public void TestCallMethodWithTooSmallResultsBuffer()
+        {
+            var engine = REngine.GetInstance();
+            ClrProxy.LoadAssembly(PATH);
+
+            var sexp = engine.CreateNumeric(0.0);
+            var arguments = new[] { (long)sexp.DangerousGetHandle() };
+            var results = new long[1];
+            Assert.IsFalse(CallStaticMethod("AssemblyForTests.StaticClass", "TryGetValue", arguments, results, out var resultsSize));
+            Assert.AreEqual(0, resultsSize);
+        }
+
+        #region Native host buffers
+
+        // Mimics the native host which owns the arguments and results buffers.
+        // The results capacity is the returned value plus one per argument for the out or ref ones.
+
+        private static bool CallStaticMethod(string typeName, string methodName, long[] arguments, out long[] results, out int resultsSize)
+        {
+            results = new long[(arguments?.Length ?? 0) + 1];
+            return CallStaticMethod(typeName, methodName, arguments, results, out resultsSize);
+        }
+
+        private static unsafe bool CallStaticMethod(string typeName, string methodName, long[] arguments, long[] results, out int resultsSize)
+        {
+            fixed (long* argumentsPtr = arguments)
+            fixed (long* resultsPtr = results)
+                return ClrProxy.CallStaticMethod(typeName, methodName, argumentsPtr, null, arguments?.Length ?? 0, resultsPtr, results.Length, out resultsSize);
+        }
+
+        private static unsafe bool CallMethod(long objectPtr, string methodName, long[] arguments, out long[] results, out int resultsSize)
+        {
+            results = new long[(arguments?.Length ?? 0) + 1];
+            fixed (long* argumentsPtr = arguments)
+            fixed (long* resultsPtr = results)
+                return ClrProxy.CallMethod(objectPtr, methodName, argumentsPtr, null, arguments?.Length ?? 0, resultsPtr, results.Length, out resultsSize);
+        }
+
+        private static unsafe bool CreateObject(string typeName, long[] arguments, out long objectPtr)
+        {
+            fixed (long* argumentsPtr = arguments)
+                return ClrProxy.CreateObject(typeName, argumentsPtr, null, arguments?.Length ?? 0, out objectPtr);
+        }
+
+        #endregion
+
         private static IConverter C(Type type)
         {
             var converter = Substitute.For<IConverter>();
@@ -0,0 +1,76 @@
+﻿using System;
+using NUnit.Framework;
+
+namespace Sharper.Tests
+{
+    [TestFixture]
+    public class ObjectTableTests
+    {
+        [Test]
+        public void TestAddGetAndRelease()
+        {
+            var instance = new object();
+            var count = ObjectTable.Count;
+
+            var handle = ObjectTable.Add(instance);
+            Assert.AreNotEqual(IntPtr.Zero, handle);
+            Assert.AreSame(instance, ObjectTable.Get(handle));
+            Assert.AreEqual(count + 1, ObjectTable.Count);
+
+            ObjectTable.Release(handle);
+            Assert.AreEqual(count, ObjectTable.Count);
+        }
+
+        [Test]
+        public void TestSameObjectGetsManyHandles()
+        {
+            var instance = new object();
+            var first = ObjectTable.Add(instance);
+            var second = ObjectTable.Add(instance);
+            Assert.AreNotEqual(first, second);
+
+            ObjectTable.Release(first);
+            Assert.AreSame(instance, ObjectTable.Get(second));
+            ObjectTable.Release(second);
+        }
+
+        [Test]
+        public void TestStaleHandleIsDetected()
+        {
+            var handle = ObjectTable.Add(new object());
+            ObjectTable.Release(handle);
+
+            Assert.Throws<ObjectDisposedException>(() => ObjectTable.Get(handle));
+            Assert.Throws<ObjectDisposedException>(() => ObjectTable.Release(handle));
+
+            // The slot is reused with another generation
+            var other = new object();
+            var reused = ObjectTable.Add(other);
+            Assert.AreNotEqual(handle, reused);
+            Assert.Throws<ObjectDisposedException>(() => ObjectTable.Get(handle));
+            Assert.AreSame(other, ObjectTable.Get(reused));
+            ObjectTable.Release(reused);
+        }
+
+        [Test]
+        public void TestUnknownHandle()
+        {
+            Assert.Throws<ObjectDisposedException>(() => ObjectTable.Get(IntPtr.Zero));
+            Assert.Throws<ObjectDisposedException>(() => ObjectTable.Get(new IntPtr(int.MaxValue)));
+        }
+
+        [Test]
+        public void TestManySlabs()
+        {
+            var handles = new IntPtr[10000];
+            for (var i = 0; i < handles.Length; i++)
+                handles[i] = ObjectTable.Add(i);
+
+            for (var i = 0; i < handles.Length; i++)
+                Assert.AreEqual(i, ObjectTable.Get(handles[i]));
+
+            foreach (var handle in handles)
+                ObjectTable.Release(handle);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+﻿using System;
+using NUnit.Framework;
+using Sharper.Converters.Resources;
+
+namespace Sharper.Tests
+{
+    [TestFixture]
+    public class PosixTimeTests
+    {
+        [TestCase("UTC")]
+        [TestCase("GMT")]
+        [TestCase("Etc/GMT")]
+        [TestCase("Etc/UTC")]
+        public void TestUtcAliases(string tzone)
+        {
+            Assert.AreSame(TimeZoneInfo.Utc, tzone.GetWindowsTimezone());
+        }
+
+        [Test]
+        public void TestResolveTimezone()
+        {
+            Assert.AreSame(TimeZoneInfo.Local, ((string)null).GetWindowsTimezone());
+            Assert.AreSame(TimeZoneInfo.Local, "".GetWindowsTimezone());
+            Assert.AreSame(TimeZoneInfo.Local, "Nowhere/Unknown".GetWindowsTimezone());
+
+            var paris = "Europe/Paris".GetWindowsTimezone();
+            Assert.AreEqual(TimeSpan.FromHours(1), paris.BaseUtcOffset);
+            Assert.AreSame(paris, "Europe/Paris".GetWindowsTimezone());
+        }
+
+        [Test]
+        public void TestUtcRoundTrip()
+        {
+            var seconds = new[] { 0.0, 1.5, -86400.25, 1.6e9 + 0.125 };
+
+            var dateTimes = seconds.FromTicks(TimeZoneInfo.Utc);
+            Assert.AreEqual(ResourcesLoader.Origin, dateTimes[0]);
+            Assert.AreEqual(new DateTime(2020, 9, 13, 12, 26, 40, 125, DateTimeKind.Utc), dateTimes[3]);
+            foreach (var dateTime in dateTimes)
+                Assert.AreEqual(DateTimeKind.Utc, dateTime.Kind);
+
+            CollectionAssert.AreEqual(seconds, dateTimes.ToTicks(out var tzone));
+            Assert.AreSame(ResourcesLoader.UtcOlsonTimezone, tzone);
+        }
+
+        [Test]
+        public void TestConvertToTimezone()
+        {
+            var paris = "Europe/Paris".GetWindowsTimezone();
+            // 2020-01-01 and 2020-07-01 at noon UTC, in winter and summer time
+            var dateTimes = new[] { 1577880000.0, 1593604800.0 }.FromTicks(paris);
+
+            Assert.AreEqual(new DateTime(2020, 1, 1, 13, 0, 0), dateTimes[0]);
+            Assert.AreEqual(new DateTime(2020, 7, 1, 14, 0, 0), dateTimes[1]);
+            Assert.AreEqual(dateTimes[0], 1577880000.0.FromTicks(paris));
+        }
+
+        [Test]
+        public void TestMatrixRoundTrip()
+        {
+            var seconds = new[,] { { 0.0, 60.0, 120.0 }, { 3600.0, 86400.0, 1.6e9 } };
+
+            var dateTimes = seconds.FromTicks(TimeZoneInfo.Utc);
+            Assert.AreEqual(2, dateTimes.GetLength(0));
+            Assert.AreEqual(3, dateTimes.GetLength(1));
+            Assert.AreEqual(ResourcesLoader.Origin.AddSeconds(60), dateTimes[0, 1]);
+            Assert.AreEqual(ResourcesLoader.Origin.AddHours(1), dateTimes[1, 0]);
+
+            CollectionAssert.AreEqual(seconds, dateTimes.ToTicks(out _));
+            Assert.AreEqual(0, new double[0, 2].FromTicks(TimeZoneInfo.Utc).Length);
+        }
+    }
+}
@@ -0,0 +1,40 @@
+﻿using System;
+using System.Collections.Generic;
+using NUnit.Framework;
+using Sharper.Converters;
+
+namespace Sharper.Tests
+{
+    [TestFixture]
+    public class RDataFrameTests
+    {
+        [Test]
+        public void TestAddAndGetColumns()
+        {
+            var frame = new RDataFrame(3)
+                .Add("x", new[] { 1.0, 2.0, RDataFrame.NaReal })
+                .Add("y", new[] { "a", null, "c" });
+
+            Assert.AreEqual(3, frame.RowCount);
+            Assert.AreEqual(2, frame.ColumnCount);
+            CollectionAssert.AreEqual(new[] { "x", "y" }, frame.Names);
+            Assert.IsTrue(frame.Contains("y"));
+            Assert.IsFalse(frame.Contains("z"));
+            Assert.AreSame(frame[0], frame["x"]);
+            Assert.IsTrue(double.IsNaN(frame.GetColumn<double>("x")[2]));
+            Assert.IsNull(frame.GetColumn<string>("y")[1]);
+        }
+
+        [Test]
+        public void TestInvalidColumns()
+        {
+            var frame = new RDataFrame(2).Add("x", new[] { 1, 2 });
+
+            Assert.Throws<ArgumentException>(() => frame.Add("y", new[] { 1, 2, 3 }));
+            Assert.Throws<ArgumentException>(() => frame.Add("x", new[] { 3, 4 }));
+            Assert.Throws<ArgumentException>(() => frame.Add("y", new[] { 1f, 2f }));
+            Assert.Throws<InvalidCastException>(() => frame.GetColumn<double>("x"));
+            Assert.Throws<KeyNotFoundException>(() => frame.GetColumn<int>("y"));
+        }
+    }
+}
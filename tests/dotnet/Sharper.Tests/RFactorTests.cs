@@ -0,0 +1,46 @@
+﻿using System;
+using NUnit.Framework;
+using Sharper.Converters;
+
+namespace Sharper.Tests
+{
+    [TestFixture]
+    public class RFactorTests
+    {
+        private enum Side { Buy, Sell }
+
+        [Test]
+        public void TestEncodeAndDecode()
+        {
+            var factor = RFactor.Encode(new[] { "b", "a", null, "b" });
+
+            CollectionAssert.AreEqual(new[] { 0, 1, RFactor.NaCode, 0 }, factor.Codes);
+            CollectionAssert.AreEqual(new[] { "b", "a" }, factor.Levels);
+            Assert.AreEqual(4, factor.Length);
+            Assert.IsNull(factor[2]);
+
+            var labels = factor.ToArray();
+            CollectionAssert.AreEqual(new[] { "b", "a", null, "b" }, labels);
+            Assert.AreSame(labels[0], labels[3]);
+        }
+
+        [Test]
+        public void TestToEnums()
+        {
+            var factor = new RFactor(new[] { 1, 0, 1 }, new[] { "Buy", "Sell" });
+
+            CollectionAssert.AreEqual(new[] { Side.Sell, Side.Buy, Side.Sell }, factor.ToEnums<Side>());
+            CollectionAssert.AreEqual(new[] { Side.Sell, Side.Buy, Side.Sell }, factor.ToEnums(typeof(Side)));
+
+            Assert.Throws<ArgumentException>(() => new RFactor(new[] { 0 }, new[] { "Hold" }).ToEnums<Side>());
+            Assert.Throws<InvalidCastException>(() => new RFactor(new[] { RFactor.NaCode }, new[] { "Buy" }).ToEnums<Side>());
+        }
+
+        [Test]
+        public void TestInvalidCodes()
+        {
+            Assert.Throws<ArgumentOutOfRangeException>(() => new RFactor(new[] { 2 }, new[] { "a", "b" }));
+            Assert.Throws<ArgumentOutOfRangeException>(() => new RFactor(new[] { -2 }, new[] { "a" }));
+        }
+    }
+}
@@ -0,0 +1,94 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using NUnit.Framework;
+using Sharper.Converters;
+
+namespace Sharper.Tests
+{
+    [TestFixture]
+    public class RMatrixTests
+    {
+        [TestCase(1, 1)]
+        [TestCase(1, 40)]
+        [TestCase(40, 1)]
+        [TestCase(33, 65)]
+        [TestCase(100, 3)]
+        [TestCase(0, 5)]
+        public void TestToArrayAndCopyFrom(int rowCount, int columnCount)
+        {
+            // Column-major as R stores it
+            var data = new double[rowCount * columnCount];
+            for (var i = 0; i < data.Length; i++)
+                data[i] = i;
+
+            var handle = GCHandle.Alloc(data, GCHandleType.Pinned);
+            try
+            {
+                var matrix = new RMatrix<double>(handle.AddrOfPinnedObject(), rowCount, columnCount);
+                var array = matrix.ToArray();
+                Assert.AreEqual(rowCount, array.GetLength(0));
+                Assert.AreEqual(columnCount, array.GetLength(1));
+                for (var i = 0; i < rowCount; i++)
+                for (var j = 0; j < columnCount; j++)
+                    Assert.AreEqual(data[j * rowCount + i], array[i, j]);
+
+                matrix.AsSpan().Clear();
+                matrix.CopyFrom(array);
+                for (var i = 0; i < data.Length; i++)
+                    Assert.AreEqual(i, data[i]);
+            }
+            finally
+            {
+                handle.Free();
+            }
+        }
+
+        [Test]
+        public void TestIndexerAndColumns()
+        {
+            var data = new[] { 1, 2, 3, 4, 5, 6 };
+            var handle = GCHandle.Alloc(data, GCHandleType.Pinned);
+            try
+            {
+                var matrix = new RMatrix<int>(handle.AddrOfPinnedObject(), 2, 3);
+                Assert.AreEqual(6, matrix.Length);
+                Assert.AreEqual(4, matrix[1, 1]);
+                CollectionAssert.AreEqual(new[] { 5, 6 }, matrix.Column(2).ToArray());
+
+                matrix[0, 2] = 10;
+                Assert.AreEqual(10, data[4]);
+
+                Assert.Throws<IndexOutOfRangeException>(() => matrix[2, 0] = 0);
+                Assert.Throws<ArgumentOutOfRangeException>(() => matrix.Column(3));
+                Assert.Throws<ArgumentException>(() => matrix.CopyFrom(new int[3, 2]));
+            }
+            finally
+            {
+                handle.Free();
+            }
+        }
+
+        [Test]
+        public void TestReadOnly()
+        {
+            var data = new[] { 1, 2, 3, 4, 5, 6 };
+            var handle = GCHandle.Alloc(data, GCHandleType.Pinned);
+            try
+            {
+                var matrix = new RMatrix<int>(IntPtr.Zero, handle.AddrOfPinnedObject(), 2, 3, true);
+                Assert.AreEqual(4, matrix[1, 1]);
+                CollectionAssert.AreEqual(new[] { 5, 6 }, matrix.ReadOnlyColumn(2).ToArray());
+
+                Assert.Throws<InvalidOperationException>(() => matrix[0, 2] = 10);
+                Assert.Throws<InvalidOperationException>(() => matrix.Column(2));
+                Assert.Throws<InvalidOperationException>(() => matrix.AsSpan());
+                Assert.Throws<InvalidOperationException>(() => matrix.CopyFrom(new int[2, 3]));
+                CollectionAssert.AreEqual(new[] { 1, 2, 3, 4, 5, 6 }, data);
+            }
+            finally
+            {
+                handle.Free();
+            }
+        }
+    }
+}
@@ -0,0 +1,100 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Reflection;
+using NUnit.Framework;
+using Sharper.Converters;
+
+namespace Sharper.Tests
+{
+    [TestFixture]
+    public class ResolutionCacheTests
+    {
+        private const BindingFlags STATIC = BindingFlags.Public | BindingFlags.Static;
+
+        private static readonly Type[] doubleTypes = { typeof(double), typeof(double[]) };
+        private static readonly Type[] stringTypes = { typeof(string), typeof(string[]) };
+
+        [Test]
+        public void TestHierarchyIsComputedOnce()
+        {
+            var hierarchy = typeof(List<int>).GetFullHierarchy();
+            Assert.AreEqual(typeof(List<int>), hierarchy[0]);
+            Assert.AreEqual(typeof(object), hierarchy[hierarchy.Length - 1]);
+
+            var hits = GetCounter("hits", 0);
+            Assert.AreSame(hierarchy, typeof(List<int>).GetFullHierarchy());
+            Assert.AreEqual(hits + 1, GetCounter("hits", 0));
+        }
+
+        [Test]
+        public void TestOverloadIsResolvedOncePerSignature()
+        {
+            typeof(Overloads).TryGetMethod(nameof(Overloads.Run), STATIC, Converters(doubleTypes), out var method).CheckIsTrue();
+            Assert.AreEqual(typeof(double), method.GetParameters()[0].ParameterType);
+
+            // The same types in another array hit the cache
+            var hits = GetCounter("hits", 1);
+            typeof(Overloads).TryGetMethod(nameof(Overloads.Run), STATIC, Converters((Type[])doubleTypes.Clone()), out var cached).CheckIsTrue();
+            Assert.AreSame(method, cached);
+            Assert.AreEqual(hits + 1, GetCounter("hits", 1));
+
+            typeof(Overloads).TryGetMethod(nameof(Overloads.Run), STATIC, Converters(stringTypes), out method).CheckIsTrue();
+            Assert.AreEqual(typeof(string), method.GetParameters()[0].ParameterType);
+
+            typeof(Overloads).TryGetMethod(nameof(Overloads.Run), STATIC, Converters(doubleTypes, stringTypes), out method).CheckIsTrue();
+            Assert.AreEqual(2, method.GetParameters().Length);
+        }
+
+        [Test]
+        public void TestNullArgument()
+        {
+            typeof(Overloads).TryGetMethod(nameof(Overloads.Run), STATIC, new[] { NullConverter.Instance }, out var method).CheckIsTrue();
+            typeof(Overloads).TryGetMethod(nameof(Overloads.Run), STATIC, Converters(new[] { typeof(void) }), out method).CheckIsFalse();
+        }
+
+        [Test]
+        public void TestMissingOverloadIsNotCached()
+        {
+            var misses = GetCounter("misses", 1);
+            typeof(Overloads).TryGetMethod(nameof(Overloads.Run), STATIC, Converters(new[] { typeof(DateTime) }), out _).CheckIsFalse();
+            typeof(Overloads).TryGetMethod(nameof(Overloads.Run), STATIC, Converters(new[] { typeof(DateTime) }), out _).CheckIsFalse();
+            Assert.AreEqual(misses + 2, GetCounter("misses", 1));
+        }
+
+        [Test]
+        public void TestConstructor()
+        {
+            typeof(Overloads).TryGetConstructor(Converters(stringTypes), out var ctor).CheckIsTrue();
+            Assert.AreEqual(typeof(string), ctor.GetParameters()[0].ParameterType);
+            typeof(Overloads).TryGetConstructor(Converters(stringTypes), out var cached).CheckIsTrue();
+            Assert.AreSame(ctor, cached);
+        }
+
+        private static double GetCounter(string name, int cache)
+            => ((double[])ResolutionCache.GetStatistics()[name])[cache];
+
+        private static IConverter[] Converters(params Type[][] types)
+            => Array.ConvertAll(types, p => (IConverter)new TypesConverter(p));
+
+        private class TypesConverter : IConverter
+        {
+            private readonly Type[] _types;
+
+            public TypesConverter(Type[] types) => _types = types;
+
+            public Type[] GetClrTypes() => _types;
+
+            public object Convert(Type type) => null;
+        }
+
+        public class Overloads
+        {
+            public Overloads(string name) { }
+            public Overloads(double value) { }
+
+            public static int Run(double value) => 1;
+            public static int Run(string value) => 2;
+            public static int Run(double value, string name) => 3;
+        }
+    }
+}
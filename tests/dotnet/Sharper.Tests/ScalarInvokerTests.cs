@@ -0,0 +1,119 @@
+﻿using System;
+using NUnit.Framework;
+using Sharper.CallSites;
+
+namespace Sharper.Tests
+{
+    [TestFixture]
+    public unsafe class ScalarInvokerTests
+    {
+        [Test]
+        public void TestStaticMethod()
+        {
+            ScalarInvoker.TryCreate(typeof(Scalars).GetMethod(nameof(Scalars.Price)), out var invoker).CheckIsTrue();
+            Assert.AreEqual(ScalarKind.Double, invoker.ReturnKind);
+            Assert.AreEqual(new[] { ScalarKind.Double, ScalarKind.Double, ScalarKind.Integer }, invoker.ParameterKinds);
+
+            var args = stackalloc long[3];
+            args[0] = BitConverter.DoubleToInt64Bits(10.5);
+            args[1] = BitConverter.DoubleToInt64Bits(0.5);
+            args[2] = 3;
+            var result = 0.0;
+            invoker.Invoke(null, (IntPtr)args, (IntPtr)(&result));
+            Assert.AreEqual(30.0, result);
+        }
+
+        [Test]
+        public void TestInstanceMethod()
+        {
+            ScalarInvoker.TryCreate(typeof(Scalars).GetMethod(nameof(Scalars.IsAbove)), out var invoker).CheckIsTrue();
+            Assert.AreEqual(ScalarKind.Logical, invoker.ReturnKind);
+
+            var args = stackalloc long[1];
+            args[0] = BitConverter.DoubleToInt64Bits(6);
+            var result = -1;
+            invoker.Invoke(new Scalars { Threshold = 5 }, (IntPtr)args, (IntPtr)(&result));
+            Assert.AreEqual(1, result);
+            invoker.Invoke(new Scalars { Threshold = 7 }, (IntPtr)args, (IntPtr)(&result));
+            Assert.AreEqual(0, result);
+        }
+
+        [Test]
+        public void TestStructInstanceIsUpdated()
+        {
+            ScalarInvoker.TryCreate(typeof(Counter).GetMethod(nameof(Counter.Next)), out var invoker).CheckIsTrue();
+
+            object counter = new Counter();
+            var args = stackalloc long[1];
+            args[0] = 2;
+            var result = 0;
+            invoker.Invoke(counter, (IntPtr)args, (IntPtr)(&result));
+            invoker.Invoke(counter, (IntPtr)args, (IntPtr)(&result));
+            Assert.AreEqual(4, result);
+            Assert.AreEqual(4, ((Counter)counter).Value);
+        }
+
+        [Test]
+        public void TestVoidMethod()
+        {
+            ScalarInvoker.TryCreate(typeof(Scalars).GetMethod(nameof(Scalars.Reset)), out var invoker).CheckIsTrue();
+            Assert.AreEqual(ScalarKind.Void, invoker.ReturnKind);
+            Assert.AreEqual(new[] { ScalarKind.Logical }, invoker.ParameterKinds);
+
+            var scalars = new Scalars { Threshold = 5 };
+            var args = stackalloc long[1];
+            args[0] = 1;
+            invoker.Invoke(scalars, (IntPtr)args, IntPtr.Zero);
+            Assert.AreEqual(0.0, scalars.Threshold);
+        }
+
+        [Test]
+        public void TestNotScalarMethods()
+        {
+            ScalarInvoker.TryCreate(typeof(Scalars).GetMethod(nameof(Scalars.Long)), out _).CheckIsFalse();
+            ScalarInvoker.TryCreate(typeof(Scalars).GetMethod(nameof(Scalars.Array)), out _).CheckIsFalse();
+            ScalarInvoker.TryCreate(typeof(Scalars).GetMethod(nameof(Scalars.Out)), out _).CheckIsFalse();
+            ScalarInvoker.TryCreate(typeof(Scalars).GetMethod(nameof(Scalars.Text)), out _).CheckIsFalse();
+            ScalarInvoker.TryCreate(typeof(Scalars).GetMethod(nameof(Scalars.Generic)), out _).CheckIsFalse();
+        }
+
+        private class Scalars
+        {
+            public double Threshold { get; set; }
+
+            public static double Price(double spot, double strike, int quantity) => (spot - strike) * quantity;
+
+            public bool IsAbove(double value) => value > Threshold;
+
+            public void Reset(bool reset)
+            {
+                if (reset) Threshold = 0;
+            }
+
+            public static long Long(long value) => value;
+
+            public static double Array(double[] values) => values[0];
+
+            public static bool Out(out double value)
+            {
+                value = 1;
+                return true;
+            }
+
+            public static string Text(int value) => value.ToString();
+
+            public static T Generic<T>(T value) => value;
+        }
+
+        private struct Counter
+        {
+            public int Value;
+
+            public int Next(int step)
+            {
+                Value += step;
+                return Value;
+            }
+        }
+    }
+}
@@ -0,0 +1,51 @@
+﻿using System.Text;
+using NUnit.Framework;
+
+namespace Sharper.Tests
+{
+    [TestFixture]
+    public class TypeIndexTests
+    {
+        [Test]
+        public void TestGetTypeFromFullName()
+        {
+            TypeIndex.TryGetType("Sharper.ClrProxy", out var type).CheckIsTrue();
+            Assert.AreEqual(typeof(ClrProxy), type);
+
+            TypeIndex.TryGetType("Sharper.Unknown", out type).CheckIsFalse();
+            type.CheckIsNull();
+        }
+
+        [Test]
+        public void TestGetTypeFromQualifiedName()
+        {
+            TypeIndex.TryGetType("Sharper.ClrProxy", "Sharper", out var type).CheckIsTrue();
+            Assert.AreEqual(typeof(ClrProxy), type);
+
+            TypeIndex.TryGetType("Sharper.ClrProxy", "Unknown", out type).CheckIsFalse();
+
+            "Sharper.ClrProxy, Sharper".TryGetType(out type, out var errorMsg).CheckIsTrue();
+            Assert.AreEqual(typeof(ClrProxy), type);
+
+            "Sharper.ClrProxy, Unknown".TryGetType(out type, out errorMsg).CheckIsFalse();
+            errorMsg.CheckIsNotNull();
+        }
+
+        [Test]
+        public void TestGetTypeFromTestAssembly()
+        {
+            TypeIndex.TryGetType(typeof(TypeIndexTests).FullName, out var type).CheckIsTrue();
+            Assert.AreEqual(typeof(TypeIndexTests), type);
+
+            TypeIndex.TryGetAssemblyByFileName(typeof(TypeIndexTests).Assembly.ManifestModule.Name, out var assembly).CheckIsTrue();
+            Assert.AreEqual(typeof(TypeIndexTests).Assembly, assembly);
+        }
+
+        [Test]
+        public void TestGetTypeFromNotIndexedSyntax()
+        {
+            typeof(StringBuilder).AssemblyQualifiedName.TryGetType(out var type, out _).CheckIsTrue();
+            Assert.AreEqual(typeof(StringBuilder), type);
+        }
+    }
+}